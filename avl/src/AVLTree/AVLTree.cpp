@@ -1,7 +1,174 @@
 #include "AVLTree.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <future>
 #include <iostream>
+#include <sstream>
+#include <thread>
+#include <vector>
+#include "../Dict/Batch.hpp"
+#include "../FrozenDict/FrozenDict.hpp"
+#include "../Serialization/BufferedWriter.hpp"
+#include "../Serialization/Snapshot.hpp"
 
 
+Node* AVLTree::createNode(int element) {
+    if (this->arena != nullptr) {
+        return this->arena->allocate(element);
+    }
+    if (this->orderStatistics) {
+        return new RankedNode(element);
+    }
+    return new Node(element);
+}
+
+void AVLTree::updateNode(Node* node) {
+    node->height = std::max(height(node->left), height(node->right)) + 1;
+    if (this->orderStatistics) {
+        static_cast<RankedNode*>(node)->count =
+            subtreeCount(node->left) + 1 + subtreeCount(node->right);
+    }
+}
+
+int AVLTree::subtreeCount(Node* node) {
+    return (node == nullptr) ? 0 : static_cast<RankedNode*>(node)->count;
+}
+
+void AVLTree::destroyNode(Node* node) {
+    if (this->arena != nullptr) {
+        this->arena->release(node);
+    } else if (this->orderStatistics) {
+        delete static_cast<RankedNode*>(node);
+    } else {
+        delete node;
+    }
+}
+
+void AVLTree::clear() {
+    if (this->arena != nullptr) {
+        // La arena libera todos sus bloques sin recorrer los nodos
+        this->arena->clear();
+    } else {
+        this->clear(this->root);
+    }
+    this->root = nullptr;
+    this->size = 0;
+}
+
+Node* AVLTree::buildSubtree(const int* elements, size_t count, Node* parent) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    // El elemento central es la raíz; cada mitad forma un subárbol
+    size_t middle = count / 2;
+    Node* node = createNode(elements[middle]);
+    node->parent = parent;
+    node->left = buildSubtree(elements, middle, node);
+    node->right = buildSubtree(elements + middle + 1, count - middle - 1, node);
+    updateNode(node);
+    return node;
+}
+
+Node* AVLTree::linkSubtree(Node* const* nodes, size_t count, Node* parent) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    size_t middle = count / 2;
+    Node* node = nodes[middle];
+    node->parent = parent;
+    node->left = linkSubtree(nodes, middle, node);
+    node->right = linkSubtree(nodes + middle + 1, count - middle - 1, node);
+    updateNode(node);
+    return node;
+}
+
+void AVLTree::collectInOrder(Node* node, std::vector<Node*>& nodes) {
+    if (node == nullptr) {
+        return;
+    }
+    collectInOrder(node->left, nodes);
+    nodes.push_back(node);
+    collectInOrder(node->right, nodes);
+}
+
+bool AVLTree::preferRebuild(size_t count) const {
+    // log2(n) redondeado hacia arriba
+    size_t depth = 1;
+    while ((static_cast<size_t>(1) << depth) <= static_cast<size_t>(size)) {
+        ++depth;
+    }
+    return count * depth >= static_cast<size_t>(size);
+}
+
+void AVLTree::buildFromSorted(const int* elements, size_t count) {
+    // Verificar el orden; los repetidos obligan a compactar una copia
+    bool repeated = false;
+    for (size_t i = 1; i < count; ++i) {
+        if (elements[i - 1] > elements[i]) {
+            this->buildFromUnsorted(elements, count);
+            return;
+        }
+        if (elements[i - 1] == elements[i]) {
+            repeated = true;
+        }
+    }
+
+    if (repeated) {
+        std::vector<int> unique(elements, elements + count);
+        unique.erase(std::unique(unique.begin(), unique.end()), unique.end());
+        this->clear();
+        this->root = buildSubtree(unique.data(), unique.size(), nullptr);
+        this->size = static_cast<int>(unique.size());
+        return;
+    }
+
+    this->clear();
+    this->root = buildSubtree(elements, count, nullptr);
+    this->size = static_cast<int>(count);
+}
+
+void AVLTree::buildFromUnsorted(const int* elements, size_t count) {
+    std::vector<int> sorted(elements, elements + count);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    this->clear();
+    this->root = buildSubtree(sorted.data(), sorted.size(), nullptr);
+    this->size = static_cast<int>(sorted.size());
+}
+
+bool AVLTree::saveSnapshot(const char* path) const {
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written;
+    {
+        SnapshotWriter snapshot(file);
+        for (int key : *this) {
+            snapshot.add(key);
+        }
+        written = snapshot.finish();
+    }
+    return std::fclose(file) == 0 && written;
+}
+
+void AVLTree::loadSnapshot(const char* path) {
+    MappedSnapshot snapshot(path);
+    buildFromSorted(snapshot.keys(), snapshot.count());
+}
+
+FrozenDict AVLTree::freeze() const {
+    std::vector<int> keys;
+    keys.reserve(size);
+    for (int key : *this) {
+        keys.push_back(key);
+    }
+    return FrozenDict(keys.data(), keys.size());
+}
+
 void AVLTree::clear(Node* node) {
     // Si el nodo es nulo, no hacer nada
     if (node == nullptr) {
@@ -13,13 +180,13 @@ void AVLTree::clear(Node* node) {
     this->clear(node->right);
 
     // Eliminar el nodo
-    delete node;
+    this->destroyNode(node);
 }
 
 void AVLTree::insert(int element) {
     // if root is null, create a new node and set it as root
     if (this->root == nullptr) {
-        this->root = new Node(element);
+        this->root = createNode(element);
         size++;
         return;
     } else {
@@ -39,7 +206,7 @@ void AVLTree::insert(int element) {
         }
 
         // create a new node and set it as the child of the parent node
-        Node* newNode = new Node(element);
+        Node* newNode = createNode(element);
         if (element < parent->data) {
             parent->left = newNode;
             parent->left->parent = parent;
@@ -75,6 +242,151 @@ bool AVLTree::contains(int element) {
     return false; // element not found
 }
 
+void AVLTree::insertMany(const int* elements, size_t count) {
+    std::vector<int> keys = batch::sortedUnique(elements, count);
+
+    if (this->root == nullptr) {
+        this->buildFromSorted(keys.data(), keys.size());
+        return;
+    }
+
+    if (!preferRebuild(keys.size())) {
+        for (int key : keys) {
+            this->insert(key);
+        }
+        return;
+    }
+
+    // Mezclar el recorrido en orden con el lote, creando solo los nodos nuevos
+    std::vector<Node*> existing;
+    existing.reserve(size);
+    collectInOrder(this->root, existing);
+
+    std::vector<Node*> merged;
+    merged.reserve(existing.size() + keys.size());
+    size_t i = 0;
+    size_t j = 0;
+    while (i < existing.size() || j < keys.size()) {
+        if (j == keys.size() || (i < existing.size() && existing[i]->data < keys[j])) {
+            merged.push_back(existing[i++]);
+        } else if (i == existing.size() || keys[j] < existing[i]->data) {
+            merged.push_back(createNode(keys[j++]));
+        } else {
+            merged.push_back(existing[i++]); // element already exists in the tree
+            ++j;
+        }
+    }
+
+    this->root = linkSubtree(merged.data(), merged.size(), nullptr);
+    this->size = static_cast<int>(merged.size());
+}
+
+void AVLTree::containsMany(const int* elements, size_t count, std::vector<bool>& found) {
+    std::vector<std::pair<int, size_t>> entries = batch::sortedPositions(elements, count);
+    found.assign(count, false);
+    containsRange(this->root, entries.data(), entries.size(), found);
+}
+
+void AVLTree::containsPipelined(const int* elements, size_t count,
+        std::vector<bool>& found) const {
+    found.assign(count, false);
+
+    // Cada ranura sigue una búsqueda: el nodo por visitar y la posición en el lote
+    const Node* cursors[batch::PIPELINE_WIDTH];
+    size_t positions[batch::PIPELINE_WIDTH];
+    size_t active = 0;
+    size_t next = 0;
+    while (active < batch::PIPELINE_WIDTH && next < count) {
+        cursors[active] = this->root;
+        positions[active] = next++;
+        active++;
+    }
+
+    while (active > 0) {
+        size_t slot = 0;
+        while (slot < active) {
+            const Node* node = cursors[slot];
+            int element = elements[positions[slot]];
+
+            if (node != nullptr && node->data != element) {
+                // Bajar un nivel y pedir el hijo; se leerá en la próxima ronda
+                node = (element < node->data) ? node->left : node->right;
+                batch::prefetch(node);
+                cursors[slot++] = node;
+                continue;
+            }
+
+            // Búsqueda terminada: la ranura toma el siguiente elemento o se compacta
+            found[positions[slot]] = (node != nullptr);
+            if (next < count) {
+                cursors[slot] = this->root;
+                positions[slot] = next++;
+                slot++;
+            } else {
+                active--;
+                cursors[slot] = cursors[active];
+                positions[slot] = positions[active];
+            }
+        }
+    }
+}
+
+void AVLTree::containsRange(Node* node, const std::pair<int, size_t>* entries, size_t count,
+        std::vector<bool>& found) {
+    if (node == nullptr || count == 0) {
+        return;
+    }
+
+    // Separar el rango en menores, iguales y mayores al nodo
+    auto range = std::equal_range(entries, entries + count, node->data, batch::ElementLess());
+    for (auto entry = range.first; entry != range.second; ++entry) {
+        found[entry->second] = true;
+    }
+
+    containsRange(node->left, entries, range.first - entries, found);
+    containsRange(node->right, range.second, entries + count - range.second, found);
+}
+
+void AVLTree::eraseMany(const int* elements, size_t count) {
+    std::vector<int> keys = batch::sortedUnique(elements, count);
+
+    if (!preferRebuild(keys.size())) {
+        for (int key : keys) {
+            this->erase(key);
+        }
+        return;
+    }
+
+    // Filtrar el recorrido en orden y reenlazar los nodos que quedan
+    std::vector<Node*> existing;
+    existing.reserve(size);
+    collectInOrder(this->root, existing);
+
+    std::vector<Node*> kept;
+    kept.reserve(existing.size());
+    size_t j = 0;
+    for (Node* node : existing) {
+        while (j < keys.size() && keys[j] < node->data) {
+            ++j;
+        }
+        if (j < keys.size() && keys[j] == node->data) {
+            this->destroyNode(node);
+        } else {
+            kept.push_back(node);
+        }
+    }
+
+    this->root = linkSubtree(kept.data(), kept.size(), nullptr);
+    this->size = static_cast<int>(kept.size());
+}
+
+bool AVLTree::forEachElement(const std::function<void(int)>& visit) {
+    for (int key : *this) {
+        visit(key);
+    }
+    return true;
+}
+
 void AVLTree::erase(int element) {
         Node* current = this->root;
 
@@ -126,69 +438,596 @@ void AVLTree::erase(int element) {
     }
 
     // Eliminar el nodo
-    delete current;
+    Node* parent = current->parent;
+    this->destroyNode(current);
     size--;
 
-    // Rebalancear el árbol
-    this->balance(child);
+    // Rebalancear el árbol desde el padre del nodo eliminado
+    this->balance(parent);
 }
 
-std::string AVLTree::toString() {
-    std::string result;
-    result += "Size: " + std::to_string(size) + "\n";
-    result += "Elements:\n";
-    result += toString(this->root);
+Node* AVLTree::attach(Node* left, Node* node, Node* right) {
+    node->left = left;
+    node->right = right;
+    node->parent = nullptr;
+    if (left != nullptr) {
+        left->parent = node;
+    }
+    if (right != nullptr) {
+        right->parent = node;
+    }
+    updateNode(node);
+    return node;
+}
+
+Node* AVLTree::joinRight(Node* left, Node* middle, Node* right) {
+    Node* outer = left->left;
+    Node* inner = left->right;
+
+    // Colgar middle donde el borde derecho de left tiene la altura de right
+    if (height(inner) <= height(right) + 1) {
+        Node* joined = attach(inner, middle, right);
+        if (height(joined) <= height(outer) + 1) {
+            return attach(outer, left, joined);
+        }
+        // Caso Right Left: rotación doble
+        joined = rightRotate(joined);
+        return leftRotate(attach(outer, left, joined));
+    }
+
+    Node* joined = joinRight(inner, middle, right);
+    Node* result = attach(outer, left, joined);
+    if (height(joined) <= height(outer) + 1) {
+        return result;
+    }
+    // Caso Right Right: rotación simple
+    return leftRotate(result);
+}
+
+Node* AVLTree::joinLeft(Node* left, Node* middle, Node* right) {
+    Node* outer = right->right;
+    Node* inner = right->left;
+
+    // Colgar middle donde el borde izquierdo de right tiene la altura de left
+    if (height(inner) <= height(left) + 1) {
+        Node* joined = attach(left, middle, inner);
+        if (height(joined) <= height(outer) + 1) {
+            return attach(joined, right, outer);
+        }
+        // Caso Left Right: rotación doble
+        joined = leftRotate(joined);
+        return rightRotate(attach(joined, right, outer));
+    }
+
+    Node* joined = joinLeft(left, middle, inner);
+    Node* result = attach(joined, right, outer);
+    if (height(joined) <= height(outer) + 1) {
+        return result;
+    }
+    // Caso Left Left: rotación simple
+    return rightRotate(result);
+}
+
+Node* AVLTree::join(Node* left, Node* middle, Node* right) {
+    Node* result;
+    if (height(left) > height(right) + 1) {
+        result = joinRight(left, middle, right);
+    } else if (height(right) > height(left) + 1) {
+        result = joinLeft(left, middle, right);
+    } else {
+        result = attach(left, middle, right);
+    }
+    result->parent = nullptr;
     return result;
 }
 
-std::string AVLTree::toString(Node* node) {
-     if (node == nullptr) {
-        return "";
+Node* AVLTree::splitLast(Node* node, Node*& last) {
+    if (node->right == nullptr) {
+        last = node;
+        Node* rest = node->left;
+        if (rest != nullptr) {
+            rest->parent = nullptr;
+        }
+        return rest;
+    }
+    Node* rest = splitLast(node->right, last);
+    return join(node->left, node, rest);
+}
+
+Node* AVLTree::joinTwo(Node* left, Node* right) {
+    if (left == nullptr) {
+        if (right != nullptr) {
+            right->parent = nullptr;
+        }
+        return right;
+    }
+    Node* last;
+    Node* rest = splitLast(left, last);
+    return join(rest, last, right);
+}
+
+void AVLTree::splitTree(Node* node, int key, Node*& less, Node*& found, Node*& greater) {
+    if (node == nullptr) {
+        less = nullptr;
+        found = nullptr;
+        greater = nullptr;
+        return;
+    }
+
+    if (key == node->data) {
+        less = node->left;
+        greater = node->right;
+        found = node;
+    } else if (key < node->data) {
+        Node* rest;
+        splitTree(node->left, key, less, found, rest);
+        greater = join(rest, node, node->right);
+    } else {
+        Node* rest;
+        splitTree(node->right, key, rest, found, greater);
+        less = join(node->left, node, rest);
+    }
+
+    // Las raíces devueltas quedan sin padre
+    if (less != nullptr) {
+        less->parent = nullptr;
+    }
+    if (greater != nullptr) {
+        greater->parent = nullptr;
+    }
+}
+
+Node* AVLTree::copyTree(const Node* node, Node* parent) {
+    if (node == nullptr) {
+        return nullptr;
+    }
+    Node* copy = createNode(node->data);
+    copy->parent = parent;
+    copy->left = copyTree(node->left, copy);
+    copy->right = copyTree(node->right, copy);
+    updateNode(copy);
+    return copy;
+}
+
+int AVLTree::countFirst(Node* first, Node* second, int total) {
+    // Dos recorridos en preorden a la par: el primero que se acaba tiene el tamaño contado
+    std::vector<Node*> pendingFirst;
+    std::vector<Node*> pendingSecond;
+    if (first != nullptr) {
+        pendingFirst.push_back(first);
+    }
+    if (second != nullptr) {
+        pendingSecond.push_back(second);
+    }
+    int visited = 0;
+    while (!pendingFirst.empty() && !pendingSecond.empty()) {
+        for (std::vector<Node*>* pending : {&pendingFirst, &pendingSecond}) {
+            Node* node = pending->back();
+            pending->pop_back();
+            if (node->left != nullptr) {
+                pending->push_back(node->left);
+            }
+            if (node->right != nullptr) {
+                pending->push_back(node->right);
+            }
+        }
+        visited++;
+    }
+    return pendingFirst.empty() ? visited : total - visited;
+}
+
+// Altura mínima de ambos subárboles para resolverlos en hilos distintos
+static const int PARALLEL_HEIGHT = 14;
+
+// Cantidad de bifurcaciones anidadas que alcanzan para ocupar todos los hilos
+static int forkDepthLimit() {
+    static const int limit = [] {
+        unsigned int threads = std::thread::hardware_concurrency();
+        int depth = 0;
+        while ((1u << depth) < threads) {
+            ++depth;
+        }
+        return depth;
+    }();
+    return limit;
+}
+
+bool AVLTree::shouldFork(const Node* first, const Node* second, int depth) {
+    return this->arena == nullptr && depth < forkDepthLimit()
+        && height(first) >= PARALLEL_HEIGHT && height(second) >= PARALLEL_HEIGHT;
+}
+
+Node* AVLTree::unionTrees(Node* mine, const Node* other, int depth, std::atomic<int>& repeated) {
+    if (other == nullptr) {
+        return mine;
+    }
+    if (mine == nullptr) {
+        return copyTree(other, nullptr);
+    }
+
+    // Partir mine por la raíz de other y unir cada lado por separado
+    Node* less;
+    Node* found;
+    Node* greater;
+    splitTree(mine, other->data, less, found, greater);
+    if (found != nullptr) {
+        repeated++;
+    } else {
+        found = createNode(other->data);
+    }
+
+    const Node* otherLeft = other->left;
+    const Node* otherRight = other->right;
+    Node* left;
+    Node* right;
+    if (shouldFork(less, otherLeft, depth)) {
+        std::future<Node*> pending = std::async(std::launch::async, [&] {
+            return unionTrees(less, otherLeft, depth + 1, repeated);
+        });
+        right = unionTrees(greater, otherRight, depth + 1, repeated);
+        left = pending.get();
+    } else {
+        left = unionTrees(less, otherLeft, depth, repeated);
+        right = unionTrees(greater, otherRight, depth, repeated);
+    }
+    return join(left, found, right);
+}
+
+Node* AVLTree::intersectTrees(Node* mine, const Node* other, int depth, std::atomic<int>& kept) {
+    if (mine == nullptr) {
+        return nullptr;
+    }
+    if (other == nullptr) {
+        this->clear(mine);
+        return nullptr;
+    }
+
+    // Partir mine por la raíz de other e intersectar cada lado por separado
+    Node* less;
+    Node* found;
+    Node* greater;
+    splitTree(mine, other->data, less, found, greater);
+
+    const Node* otherLeft = other->left;
+    const Node* otherRight = other->right;
+    Node* left;
+    Node* right;
+    if (shouldFork(less, otherLeft, depth)) {
+        std::future<Node*> pending = std::async(std::launch::async, [&] {
+            return intersectTrees(less, otherLeft, depth + 1, kept);
+        });
+        right = intersectTrees(greater, otherRight, depth + 1, kept);
+        left = pending.get();
+    } else {
+        left = intersectTrees(less, otherLeft, depth, kept);
+        right = intersectTrees(greater, otherRight, depth, kept);
+    }
+
+    // La llave de la raíz de other se queda solo si también estaba en mine
+    if (found != nullptr) {
+        kept++;
+        return join(left, found, right);
+    }
+    return joinTwo(left, right);
+}
+
+Node* AVLTree::differenceTrees(Node* mine, const Node* other, int depth, std::atomic<int>& removed) {
+    if (mine == nullptr || other == nullptr) {
+        return mine;
     }
 
-    std::string result;
+    // Partir mine por la raíz de other y quitar cada lado por separado
+    Node* less;
+    Node* found;
+    Node* greater;
+    splitTree(mine, other->data, less, found, greater);
 
-    // Agregar espacios de indentación y la información del nodo
-    result += "Node: " + std::to_string(node->data) + "-->";
-    // Mostrar el padre
-    if (node->parent) {
-        result += " Parent: " + std::to_string(node->parent->data);
+    const Node* otherLeft = other->left;
+    const Node* otherRight = other->right;
+    Node* left;
+    Node* right;
+    if (shouldFork(less, otherLeft, depth)) {
+        std::future<Node*> pending = std::async(std::launch::async, [&] {
+            return differenceTrees(less, otherLeft, depth + 1, removed);
+        });
+        right = differenceTrees(greater, otherRight, depth + 1, removed);
+        left = pending.get();
     } else {
-        result += " Parent: None";
+        left = differenceTrees(less, otherLeft, depth, removed);
+        right = differenceTrees(greater, otherRight, depth, removed);
+    }
+
+    if (found != nullptr) {
+        this->destroyNode(found);
+        removed++;
+    }
+    return joinTwo(left, right);
+}
+
+void AVLTree::unionWith(const AVLTree& other) {
+    // other se lee mientras este árbol se parte, así que no pueden ser el mismo
+    if (&other == this) {
+        return;
+    }
+    std::atomic<int> repeated(0);
+    this->root = unionTrees(this->root, other.root, 0, repeated);
+    this->size += other.size - repeated;
+}
+
+void AVLTree::intersectWith(const AVLTree& other) {
+    if (&other == this) {
+        return;
+    }
+    std::atomic<int> kept(0);
+    this->root = intersectTrees(this->root, other.root, 0, kept);
+    this->size = kept;
+}
+
+void AVLTree::differenceWith(const AVLTree& other) {
+    if (&other == this) {
+        clear();
+        return;
+    }
+    std::atomic<int> removed(0);
+    this->root = differenceTrees(this->root, other.root, 0, removed);
+    this->size -= removed;
+}
+
+bool AVLTree::split(int key, AVLTree& greater) {
+    greater.clear();
+
+    Node* less;
+    Node* found;
+    Node* upper;
+    splitTree(this->root, key, less, found, upper);
+    if (found != nullptr) {
+        this->destroyNode(found);
+    }
+    this->root = less;
+
+    // Mover los nodos mayores si ambos árboles usan el heap y el mismo tipo de nodo; si no,
+    // copiarlos, porque un nodo de un árbol sin ORDER_STATISTICS no guarda `count`
+    int remaining = this->size - (found != nullptr ? 1 : 0);
+    int moved = this->orderStatistics ? subtreeCount(upper) : countFirst(upper, less, remaining);
+    if (this->arena == nullptr && greater.arena == nullptr
+            && this->orderStatistics == greater.orderStatistics) {
+        greater.root = upper;
+    } else {
+        greater.root = greater.copyTree(upper, nullptr);
+        this->clear(upper);
+    }
+    greater.size = moved;
+    this->size -= moved + (found != nullptr ? 1 : 0);
+    return found != nullptr;
+}
+
+int AVLTree::countBelow(int key, bool inclusive) {
+    if (!this->orderStatistics) {
+        throw std::logic_error("AVLTree: order statistics require ORDER_STATISTICS");
+    }
+
+    // Sumar los subárboles izquierdos que quedan atrás al bajar a la derecha
+    int below = 0;
+    Node* current = this->root;
+    while (current != nullptr) {
+        if (key < current->data || (!inclusive && key == current->data)) {
+            current = current->left;
+        } else {
+            below += subtreeCount(current->left) + 1;
+            current = current->right;
+        }
+    }
+    return below;
+}
+
+int AVLTree::rank(int key) {
+    return countBelow(key, false);
+}
+
+int AVLTree::select(int k) {
+    if (!this->orderStatistics) {
+        throw std::logic_error("AVLTree: order statistics require ORDER_STATISTICS");
+    }
+    if (k < 0 || k >= size) {
+        throw std::out_of_range("AVLTree: select index out of range");
     }
-    // Mostrar hijos
-    if (node->left || node->right) {
-        result += "  Children: ";
-        if (node->left) {
-            result += "Left: " + std::to_string(node->left->data);
+
+    Node* current = this->root;
+    while (true) {
+        int leftCount = subtreeCount(current->left);
+        if (k < leftCount) {
+            current = current->left;
+        } else if (k > leftCount) {
+            k -= leftCount + 1;
+            current = current->right;
         } else {
-            result += "Left: None";
+            return current->data;
         }
-        result += ", ";
-        if (node->right) {
-            result += "Right: " + std::to_string(node->right->data);
+    }
+}
+
+int AVLTree::countRange(int lo, int hi) {
+    // Si lo > hi, no hay más llaves hasta hi que menores que lo
+    int upToHi = countBelow(hi, true);
+    int belowLo = countBelow(lo, false);
+    return upToHi > belowLo ? upToHi - belowLo : 0;
+}
+
+Node* AVLTree::leftmost(Node* node) {
+    if (node == nullptr) {
+        return nullptr;
+    }
+    while (node->left != nullptr) {
+        node = node->left;
+    }
+    return node;
+}
+
+Node* AVLTree::rightmost(Node* node) {
+    if (node == nullptr) {
+        return nullptr;
+    }
+    while (node->right != nullptr) {
+        node = node->right;
+    }
+    return node;
+}
+
+Node* AVLTree::successor(Node* node) {
+    if (node->right != nullptr) {
+        return leftmost(node->right);
+    }
+    // Subir mientras se venga desde un hijo derecho
+    Node* parent = node->parent;
+    while (parent != nullptr && parent->right == node) {
+        node = parent;
+        parent = parent->parent;
+    }
+    return parent;
+}
+
+Node* AVLTree::predecessor(Node* node) {
+    if (node->left != nullptr) {
+        return rightmost(node->left);
+    }
+    // Subir mientras se venga desde un hijo izquierdo
+    Node* parent = node->parent;
+    while (parent != nullptr && parent->left == node) {
+        node = parent;
+        parent = parent->parent;
+    }
+    return parent;
+}
+
+Node* AVLTree::firstNotBelow(int key, bool strict) const {
+    Node* candidate = nullptr;
+    Node* current = this->root;
+    while (current != nullptr) {
+        if (key < current->data || (!strict && key == current->data)) {
+            candidate = current;
+            current = current->left;
         } else {
-            result += "Right: None";
+            current = current->right;
         }
-    } else {
-        result += "  No children";
     }
+    return candidate;
+}
+
+AVLTree::Iterator AVLTree::begin() const {
+    return Iterator(leftmost(this->root), this);
+}
+
+AVLTree::Iterator AVLTree::end() const {
+    return Iterator(nullptr, this);
+}
+
+AVLTree::Iterator AVLTree::lowerBound(int key) const {
+    return Iterator(firstNotBelow(key, false), this);
+}
+
+AVLTree::Iterator AVLTree::upperBound(int key) const {
+    return Iterator(firstNotBelow(key, true), this);
+}
+
+std::string AVLTree::toString() {
+    std::ostringstream stream;
+    writeTo(stream);
+    return stream.str();
+}
+
+bool AVLTree::writeTo(std::ostream& stream) {
+    BufferedWriter writer(stream);
+    writeTo(writer);
+    return writer.flush();
+}
+
+bool AVLTree::writeTo(FILE* file) {
+    BufferedWriter writer(file);
+    writeTo(writer);
+    return writer.flush();
+}
+
+std::string AVLTree::toString(Node* node) {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer, node);
+    }
+    return stream.str();
+}
 
-        result += " Height: " + std::to_string(node->height + 1);
-        result += "\n";
-    // Concatenar la información de los hijos de manera recursiva
-    result += toString(node->left);  // Aumentar indentación para el hijo izquierdo
-    result += toString(node->right); // Aumentar indentación para el hijo derecho
+void AVLTree::writeTo(BufferedWriter& writer) const {
+    writer.write("Size: ");
+    writer.write(static_cast<int>(size));
+    writer.write("\nElements:\n");
+    writeTo(writer, root);
+}
 
-    return result;
-};
+void AVLTree::writeTo(BufferedWriter& writer, const Node* node) const {
+    // Preorden con pila: se apila el hijo derecho antes que el izquierdo
+    std::vector<const Node*> pending;
+    if (node != nullptr) {
+        pending.reserve(node->height + 2);
+        pending.push_back(node);
+    }
+    while (!pending.empty()) {
+        const Node* node = pending.back();
+        pending.pop_back();
+
+        writer.write("Node: ");
+        writer.write(node->data);
+        writer.write("-->");
+        // Mostrar el padre
+        if (node->parent) {
+            writer.write(" Parent: ");
+            writer.write(node->parent->data);
+        } else {
+            writer.write(" Parent: None");
+        }
+        // Mostrar hijos
+        if (node->left || node->right) {
+            writer.write("  Children: ");
+            if (node->left) {
+                writer.write("Left: ");
+                writer.write(node->left->data);
+            } else {
+                writer.write("Left: None");
+            }
+            writer.write(", ");
+            if (node->right) {
+                writer.write("Right: ");
+                writer.write(node->right->data);
+            } else {
+                writer.write("Right: None");
+            }
+        } else {
+            writer.write("  No children");
+        }
+        writer.write(" Height: ");
+        writer.write(node->height + 1);
+        writer.write("\n");
 
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
+        }
+    }
+}
+
+size_t AVLTree::memoryUsage() {
+    if (this->arena != nullptr) {
+        return this->arena->bytesReserved();
+    }
+    return size * (this->orderStatistics ? sizeof(RankedNode) : sizeof(Node));
+}
 
 void AVLTree::balance(Node* node) {
     // Recorrer el árbol hacia arriba balanceando desde el nodo actual hasta la raíz
     while (node != nullptr) {
-        // Actualizar la altura del nodo actual
-        node->height = std::max(height(node->left), height(node->right)) + 1;
+        // Actualizar la altura (y el tamaño del subárbol) del nodo actual
+        updateNode(node);
 
         // Obtener el balance del nodo actual
         int balanceFactor = getBalance(node);
@@ -265,8 +1104,8 @@ Node* AVLTree::rightRotate(Node* y) {
     y->left = T2;
 
     // Actualizar alturas
-    y->height = std::max(height(y->left), height(y->right)) + 1;
-    x->height = std::max(height(x->left), height(x->right)) + 1;
+    updateNode(y);
+    updateNode(x);
 
     // Retornar nueva raíz
     return x;
@@ -290,14 +1129,14 @@ Node* AVLTree::leftRotate(Node* x) {
     x->right = T2;
 
     // Actualizar alturas
-    x->height = std::max(height(x->left), height(x->right)) + 1;
-    y->height = std::max(height(y->left), height(y->right)) + 1;
+    updateNode(x);
+    updateNode(y);
 
     // Retornar nueva raíz
     return y;
 }
 
-int AVLTree::height(Node* node) {
+int AVLTree::height(const Node* node) {
 return (node == nullptr) ? -1 : node->height;
 }
 
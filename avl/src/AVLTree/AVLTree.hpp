@@ -1,6 +1,17 @@
 #pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <iosfwd>
+#include <iterator>
+#include <utility>
+#include <vector>
 #include "../Dict/Dict.h"
 #include "Node.hpp"
+#include "NodeArena.hpp"
+
+class BufferedWriter;
+class FrozenDict;
 /**
  * @class AVLTree
  * @brief A class representing an binary AVLTree.
@@ -15,18 +26,358 @@ class AVLTree : public Dict {
     protected:
         Node* root; /// Pointer to the root node of the tree.
         int size;  /// The number of nodes in the tree.
+        NodeArena* arena; /// Slab arena owning the nodes, or nullptr when they live on the heap.
+        bool orderStatistics; /// Whether the nodes are `RankedNode`s that keep their subtree size.
+
+        /**
+         * @brief Recalcula la altura de un nodo y, con `ORDER_STATISTICS`, el tamaño de su subárbol.
+         *
+         * @require Los hijos del nodo deben tener sus campos ya actualizados.
+         */
+        void updateNode(Node* node);
+
+        /**
+         * @brief Devuelve la cantidad de nodos del subárbol, 0 si el nodo es nulo.
+         *
+         * @require El árbol debe usar `ORDER_STATISTICS`.
+         */
+        int subtreeCount(Node* node);
+
+        /**
+         * @brief Cuenta las llaves menores que `key`, o menores o iguales si `inclusive`, en O(log n).
+         *
+         * @throws std::logic_error si el árbol no usa `ORDER_STATISTICS`.
+         */
+        int countBelow(int key, bool inclusive);
+
+        /**
+         * @brief Devuelve el nodo con la llave mínima del subárbol, o nullptr si está vacío.
+         */
+        static Node* leftmost(Node* node);
+
+        /**
+         * @brief Devuelve el nodo con la llave máxima del subárbol, o nullptr si está vacío.
+         */
+        static Node* rightmost(Node* node);
+
+        /**
+         * @brief Devuelve el siguiente nodo en orden, o nullptr si `node` es el último.
+         *
+         * @effect Baja al mínimo del hijo derecho o sube por los padres hasta llegar desde
+         *         un hijo izquierdo; O(1) amortizado en un recorrido completo.
+         */
+        static Node* successor(Node* node);
+
+        /**
+         * @brief Devuelve el nodo anterior en orden, o nullptr si `node` es el primero.
+         */
+        static Node* predecessor(Node* node);
+
+        /**
+         * @brief Devuelve el primer nodo con llave mayor o igual que `key` (o estrictamente
+         *        mayor si `strict`), o nullptr si no existe.
+         */
+        Node* firstNotBelow(int key, bool strict) const;
+
+        /**
+         * @brief Escribe el tamaño del árbol y sus nodos en preorden con una pila explícita.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+        /**
+         * @brief Escribe los nodos del subárbol de `node` en preorden con una pila explícita.
+         */
+        void writeTo(BufferedWriter& writer, const Node* node) const;
+
+        /**
+         * @brief Obtiene un nodo nuevo para `element`, desde la arena si el árbol tiene una.
+         *
+         * @param element El valor que guardará el nodo.
+         * @return Un puntero al nodo inicializado.
+         */
+        Node* createNode(int element);
+
+        /**
+         * @brief Libera un nodo que ya no forma parte del árbol.
+         *
+         * @effect Devuelve el nodo a la lista libre de la arena o lo elimina del heap.
+         *
+         * @param node El nodo a liberar.
+         */
+        void destroyNode(Node* node);
+
+        /**
+         * @brief Construye un subárbol perfectamente balanceado a partir de un arreglo ordenado.
+         *
+         * @effect Toma el elemento central como raíz y construye recursivamente las dos mitades,
+         *         asignando padres y alturas sin realizar rotaciones.
+         *
+         * @require `elements` debe estar en orden estrictamente ascendente.
+         *
+         * @param elements Los elementos del subárbol.
+         * @param count La cantidad de elementos.
+         * @param parent El padre de la raíz del subárbol.
+         * @return La raíz del subárbol, o nullptr si `count` es cero.
+         */
+        Node* buildSubtree(const int* elements, size_t count, Node* parent);
+
+        /**
+         * @brief Enlaza nodos existentes, ya ordenados por su valor, como un subárbol perfectamente balanceado.
+         *
+         * @effect Igual que `buildSubtree`, pero reutiliza los nodos recibidos en lugar de crear nodos nuevos.
+         *
+         * @param nodes Los nodos en orden ascendente de `data`.
+         * @param count La cantidad de nodos.
+         * @param parent El padre de la raíz del subárbol.
+         * @return La raíz del subárbol, o nullptr si `count` es cero.
+         */
+        Node* linkSubtree(Node* const* nodes, size_t count, Node* parent);
+
+        /**
+         * @brief Agrega a `nodes` los nodos del subárbol en orden ascendente.
+         */
+        void collectInOrder(Node* node, std::vector<Node*>& nodes);
+
+        /**
+         * @brief Indica si conviene reconstruir el árbol en lugar de procesar un lote llave por llave.
+         *
+         * @effect Compara el costo de `count` descensos de O(log n) con el de recorrer y reenlazar
+         *         los n nodos del árbol una sola vez.
+         *
+         * @param count La cantidad de elementos del lote.
+         * @return true si el lote es lo bastante grande para preferir la reconstrucción.
+         */
+        bool preferRebuild(size_t count) const;
+
+        /**
+         * @brief Resuelve un rango del lote ordenado contra el subárbol, visitando cada nodo a lo sumo una vez.
+         *
+         * @param node La raíz del subárbol.
+         * @param entries Los pares (elemento, posición) del rango, ordenados por elemento.
+         * @param count La cantidad de pares del rango.
+         * @param found El resultado de cada búsqueda, indexado por posición.
+         */
+        void containsRange(Node* node, const std::pair<int, size_t>* entries, size_t count,
+            std::vector<bool>& found);
+
+        /**
+         * @brief Enlaza `left` y `right` como hijos de `node` y recalcula su altura.
+         *
+         * @return `node`, sin padre, como raíz del subárbol resultante.
+         */
+        Node* attach(Node* left, Node* node, Node* right);
+
+        /**
+         * @brief Une dos subárboles AVL separados por un nodo: todo `left` es menor que `middle`
+         *        y todo `right` es mayor.
+         *
+         * @effect Desciende por el lado derecho (o izquierdo) del subárbol más alto hasta encontrar
+         *         uno de altura similar al otro, cuelga allí `middle` y corrige el balance al subir
+         *         con `leftRotate` y `rightRotate`. Cuesta O(|altura(left) - altura(right)| + 1).
+         *
+         * @return La raíz del subárbol unido, sin padre.
+         */
+        Node* join(Node* left, Node* middle, Node* right);
+
+        /**
+         * @brief Caso de `join` en que `left` es más de un nivel más alto que `right`.
+         */
+        Node* joinRight(Node* left, Node* middle, Node* right);
+
+        /**
+         * @brief Caso de `join` en que `right` es más de un nivel más alto que `left`.
+         */
+        Node* joinLeft(Node* left, Node* middle, Node* right);
+
+        /**
+         * @brief Une dos subárboles AVL sin nodo intermedio, usando el máximo de `left` como separador.
+         */
+        Node* joinTwo(Node* left, Node* right);
+
+        /**
+         * @brief Separa el nodo máximo de un subárbol.
+         *
+         * @param node La raíz del subárbol, no nula.
+         * @param last Recibe el nodo máximo, ya desenlazado.
+         * @return La raíz del subárbol con el resto de los nodos.
+         */
+        Node* splitLast(Node* node, Node*& last);
+
+        /**
+         * @brief Separa un subárbol en los nodos menores y mayores que `key`.
+         *
+         * @effect Desciende buscando `key` y, al volver, une con `join` las partes que quedan de
+         *         cada lado, en O(log n).
+         *
+         * @param node La raíz del subárbol.
+         * @param key La llave de corte.
+         * @param less Recibe el subárbol con las llaves menores que `key`.
+         * @param found Recibe el nodo con `key`, desenlazado, o nullptr si no existe.
+         * @param greater Recibe el subárbol con las llaves mayores que `key`.
+         */
+        void splitTree(Node* node, int key, Node*& less, Node*& found, Node*& greater);
+
+        /**
+         * @brief Copia un subárbol con nodos propios de este árbol, conservando forma y alturas.
+         */
+        Node* copyTree(const Node* node, Node* parent);
+
+        /**
+         * @brief Cuenta los nodos de `first` sabiendo que entre `first` y `second` suman `total`.
+         *
+         * @effect Recorre ambos subárboles a la par y para cuando se acaba uno, así que cuesta
+         *         O(min(tamaño de `first`, tamaño de `second`)).
+         */
+        int countFirst(Node* first, Node* second, int total);
+
+        /**
+         * @brief Indica si conviene resolver las dos mitades de una operación en hilos distintos.
+         *
+         * @effect Solo se paraleliza con nodos del heap (la arena no es segura entre hilos), cuando
+         *         ambos subárboles son grandes y quedan hilos de hardware por ocupar.
+         *
+         * @param first Uno de los subárboles de la operación.
+         * @param second El otro subárbol de la operación.
+         * @param depth La cantidad de bifurcaciones por encima de esta llamada.
+         */
+        bool shouldFork(const Node* first, const Node* second, int depth);
+
+        /**
+         * @brief Agrega a un subárbol de este árbol las llaves de `other`, que solo se lee.
+         *
+         * @effect Parte `mine` por la raíz de `other` y une cada lado por separado. Solo se
+         *         crean nodos para las llaves de `other` que no estaban en `mine`.
+         */
+        Node* unionTrees(Node* mine, const Node* other, int depth, std::atomic<int>& repeated);
+
+        /**
+         * @brief Deja en un subárbol solo las llaves de `mine` que también están en `other`,
+         *        que solo se lee.
+         */
+        Node* intersectTrees(Node* mine, const Node* other, int depth, std::atomic<int>& kept);
+
+        /**
+         * @brief Deja en un subárbol solo las llaves de `mine` que no están en `other`, que
+         *        solo se lee.
+         */
+        Node* differenceTrees(Node* mine, const Node* other, int depth, std::atomic<int>& removed);
     public:
+        /**
+         * @class Iterator
+         * @brief A read-only bidirectional iterator over the keys of the tree in ascending order.
+         *
+         * The iterator only holds the current node, so it never allocates; each step follows
+         * the `parent` pointers, which costs O(1) amortized over a full traversal. The end
+         * iterator holds a null node and can be decremented back to the last key. Inserting
+         * or erasing keys invalidates the iterators of the tree.
+         */
+        class Iterator {
+            public:
+                using iterator_category = std::bidirectional_iterator_tag;
+                using value_type = int;
+                using difference_type = std::ptrdiff_t;
+                using pointer = const int*;
+                using reference = const int&;
+
+                /**
+                 * @brief Constructs an iterator that does not point into any tree.
+                 */
+                Iterator()
+                : node(nullptr)
+                , tree(nullptr) {
+                };
+
+                reference operator*() const {
+                    return node->data;
+                };
+
+                pointer operator->() const {
+                    return &node->data;
+                };
+
+                /**
+                 * @brief Moves to the next key in ascending order.
+                 */
+                Iterator& operator++() {
+                    node = AVLTree::successor(node);
+                    return *this;
+                };
+
+                Iterator operator++(int) {
+                    Iterator previous = *this;
+                    ++(*this);
+                    return previous;
+                };
+
+                /**
+                 * @brief Moves to the previous key; from `end()` it moves to the largest key.
+                 */
+                Iterator& operator--() {
+                    node = (node == nullptr) ? AVLTree::rightmost(tree->root) : AVLTree::predecessor(node);
+                    return *this;
+                };
+
+                Iterator operator--(int) {
+                    Iterator previous = *this;
+                    --(*this);
+                    return previous;
+                };
+
+                bool operator==(const Iterator& other) const {
+                    return node == other.node;
+                };
+
+                bool operator!=(const Iterator& other) const {
+                    return node != other.node;
+                };
+
+            private:
+                friend class AVLTree;
+
+                Iterator(Node* node, const AVLTree* tree)
+                : node(node)
+                , tree(tree) {
+                };
+
+                Node* node;           /// The current node, nullptr at the end.
+                const AVLTree* tree;  /// The tree being traversed, needed to step back from the end.
+        };
+
+        /**
+         * @brief Options accepted by the constructor, combinable with `|`.
+         *
+         * - `HEAP_NODES`: every node is requested from the heap with `new` (default).
+         * - `ARENA_NODES`: nodes are carved from a per-tree `NodeArena`, recycled through
+         *   its free list, and released chunk by chunk by `clear()`.
+         * - `ORDER_STATISTICS`: every node is a `RankedNode` that keeps the size of its
+         *   subtree, which enables `rank`, `select` and `countRange` at the cost of 8 more
+         *   bytes per node and of updating it on every change.
+         */
+        enum Options {
+            HEAP_NODES = 0,
+            ARENA_NODES = 1 << 0,
+            ORDER_STATISTICS = 1 << 1
+        };
+
         /**
          * @brief Constructs a new Tree object.
          * 
          * This constructor initializes the Tree with a null root and a size of zero.
+         *
+         * @param options A combination of `Options` selecting how nodes are stored.
          */
-        AVLTree()
+        explicit AVLTree(int options = HEAP_NODES)
         : root(nullptr)
-        , size(0) {
+        , size(0)
+        , arena((options & ARENA_NODES)
+            ? new NodeArena((options & ORDER_STATISTICS) != 0) : nullptr)
+        , orderStatistics((options & ORDER_STATISTICS) != 0) {
 
         };
 
+        AVLTree(const AVLTree&) = delete;
+        AVLTree& operator=(const AVLTree&) = delete;
+
         /**
          * @brief Destructor for the Tree class.
          *
@@ -36,9 +387,20 @@ class AVLTree : public Dict {
          * are performed when a Tree object is destroyed.
          */
         ~AVLTree() {
-            clear(root);
+            clear();
+            delete arena;
         };
 
+        /**
+         * @brief Removes every element from the AVLTree.
+         *
+         * @effect With `ARENA_NODES` the arena gives back all of its chunks at once;
+         *         otherwise every node is deleted recursively through `clear(Node*)`.
+         *
+         * @modifies Leaves the tree empty, with a null root and a size of zero.
+         */
+        void clear();
+
         /**
          * @brief Clears the AVLTree by deleting all nodes.
          *
@@ -51,6 +413,66 @@ class AVLTree : public Dict {
 
         void clear(Node* node);
 
+        /**
+         * @brief Reemplaza el contenido del árbol por los elementos de un arreglo ordenado, en O(n).
+         *
+         * @effect Vacía el árbol y lo reconstruye perfectamente balanceado sin rotaciones.
+         *         Los elementos repetidos se guardan una sola vez. Si el arreglo no está en
+         *         orden ascendente, se delega en `buildFromUnsorted`.
+         *
+         * @modifies Reemplaza todos los nodos del árbol y actualiza `size`.
+         *
+         * @param elements Los elementos en orden ascendente.
+         * @param count La cantidad de elementos del arreglo.
+         */
+        void buildFromSorted(const int* elements, size_t count);
+
+        /**
+         * @brief Reemplaza el contenido del árbol por los elementos de un arreglo en cualquier orden.
+         *
+         * @effect Copia y ordena los elementos, descarta los repetidos y construye el árbol balanceado
+         *         sin rotaciones, en O(n log n) por el ordenamiento.
+         *
+         * @modifies Reemplaza todos los nodos del árbol y actualiza `size`.
+         *
+         * @param elements Los elementos a cargar.
+         * @param count La cantidad de elementos del arreglo.
+         */
+        void buildFromUnsorted(const int* elements, size_t count);
+
+        /**
+         * @brief Guarda las llaves en orden ascendente en un archivo de instantánea binario.
+         *
+         * @effect Escribe un encabezado con la cantidad de llaves y su suma de verificación,
+         *         seguido de las llaves, en un solo recorrido en orden y sin copiarlas antes.
+         *
+         * @param path La ruta del archivo, que se reemplaza si ya existe.
+         * @return false si el archivo no pudo escribirse.
+         */
+        bool saveSnapshot(const char* path) const;
+
+        /**
+         * @brief Reemplaza el contenido del árbol con el de una instantánea.
+         *
+         * @effect Proyecta el archivo en memoria con `mmap`, valida el encabezado y la suma de
+         *         verificación, y lo construye con `buildFromSorted` en O(n) directamente desde la proyección.
+         *
+         * @throws std::runtime_error si el archivo no existe o no es una instantánea válida.
+         *
+         * @param path La ruta del archivo guardado con `saveSnapshot`.
+         */
+        void loadSnapshot(const char* path);
+
+        /**
+         * @brief Copia las llaves a un diccionario inmutable en orden de Eytzinger.
+         *
+         * @effect Recorre el árbol en orden una vez; el árbol no cambia y sigue siendo
+         *         independiente del resultado.
+         *
+         * @return Un `FrozenDict` con las mismas llaves, optimizado para búsquedas.
+         */
+        FrozenDict freeze() const;
+
         /**
          * @brief Inserta un elemento en el árbol AVL, asegurando que el árbol se mantenga balanceado.
          *
@@ -101,6 +523,213 @@ class AVLTree : public Dict {
      */
         virtual void erase(int element) override;
 
+        /**
+         * @brief Inserta un lote de elementos.
+         *
+         * @effect Ordena el lote. Si el árbol está vacío, lo construye con `buildFromSorted`; si el
+         *         lote es grande respecto al árbol, mezcla el lote con el recorrido en orden y
+         *         reenlaza todos los nodos en O(n + m); en otro caso inserta las llaves en orden
+         *         ascendente, de modo que los descensos consecutivos comparten el camino en caché.
+         *
+         * @modifies Agrega los elementos ausentes y actualiza `size`.
+         *
+         * @param elements Los elementos a insertar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Verifica un lote de elementos en una sola pasada por el árbol.
+         *
+         * @effect Ordena el lote y lo reparte desde la raíz: cada nodo se visita a lo sumo una vez
+         *         y solo si alguna llave del lote pasa por él.
+         *
+         * @modifies `found`, que queda con `found[i]` indicando si `elements[i]` está presente.
+         *
+         * @param elements Los elementos a buscar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         * @param found El resultado de cada búsqueda.
+         */
+        void containsMany(const int* elements, size_t count, std::vector<bool>& found) override;
+
+        /**
+         * @brief Verifica un lote de elementos con varias búsquedas en vuelo a la vez.
+         *
+         * @effect Mantiene hasta `batch::PIPELINE_WIDTH` búsquedas activas y las avanza un nivel
+         *         por ronda, pidiendo al caché el hijo siguiente de cada una antes de pasar a la
+         *         otra. Así las esperas a memoria de búsquedas distintas se solapan en lugar de
+         *         sumarse. No ordena el lote, por lo que conviene cuando es pequeño respecto al
+         *         árbol y `containsMany` visitaría nodos muy dispersos.
+         *
+         * @modifies `found`, que queda con `found[i]` indicando si `elements[i]` está presente.
+         *
+         * @param elements Los elementos a buscar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         * @param found El resultado de cada búsqueda.
+         */
+        void containsPipelined(const int* elements, size_t count, std::vector<bool>& found) const;
+
+        /**
+         * @brief Elimina un lote de elementos.
+         *
+         * @effect Ordena el lote. Si es grande respecto al árbol, filtra el recorrido en orden y
+         *         reenlaza los nodos que quedan en O(n + m); en otro caso elimina las llaves en
+         *         orden ascendente.
+         *
+         * @modifies Elimina los nodos encontrados y actualiza `size`.
+         *
+         * @param elements Los elementos a eliminar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         */
+        void eraseMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol en orden ascendente.
+         *
+         * @effect Recorre el árbol con `begin()` y `end()`, sin reservar memoria.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Agrega a este árbol todas las llaves de `other`.
+         *
+         * @effect Parte este árbol por las llaves de `other`, que se lee sin copiarlo, y vuelve a
+         *         unir las partes con `join`, con trabajo O(m log(n/m + 1)) para tamaños m <= n,
+         *         más un nodo nuevo por cada llave de `other` que no estaba. Las dos mitades de
+         *         cada paso se resuelven en hilos distintos cuando los subárboles son grandes y
+         *         los nodos están en el heap.
+         *
+         * @modifies Este árbol; `other` no cambia.
+         *
+         * @param other El árbol cuyas llaves se agregan.
+         */
+        void unionWith(const AVLTree& other);
+
+        /**
+         * @brief Deja en este árbol solo las llaves que también están en `other`.
+         *
+         * @effect Igual que `unionWith`, pero libera los nodos de este árbol que no están en
+         *         `other` y no crea nodos, así que el trabajo es O(m log(n/m + 1)).
+         *
+         * @modifies Este árbol; `other` no cambia.
+         *
+         * @param other El árbol contra el que se intersecta.
+         */
+        void intersectWith(const AVLTree& other);
+
+        /**
+         * @brief Quita de este árbol todas las llaves que están en `other`.
+         *
+         * @effect Igual que `unionWith`, pero libera los nodos de este árbol presentes en `other`
+         *         y no crea nodos, así que el trabajo es O(m log(n/m + 1)).
+         *
+         * @modifies Este árbol; `other` no cambia.
+         *
+         * @param other El árbol cuyas llaves se quitan.
+         */
+        void differenceWith(const AVLTree& other);
+
+        /**
+         * @brief Parte el árbol en dos alrededor de `key`.
+         *
+         * @effect Este árbol se queda con las llaves menores que `key` y `greater`, que se vacía
+         *         primero, recibe las mayores. La partición cuesta O(log n); los nodos se mueven
+         *         sin copiarse cuando ambos árboles usan el heap y el mismo modo de
+         *         `ORDER_STATISTICS`, y se copian en cualquier otro caso.
+         *         Con `ORDER_STATISTICS` el tamaño de cada parte sale de su raíz y el total es
+         *         O(log n); sin él hay que contar la parte más chica, así que cuesta
+         *         O(log n + min(llaves menores, llaves mayores)).
+         *
+         * @modifies Este árbol y `greater`.
+         *
+         * @param key La llave de corte, que se elimina si está presente.
+         * @param greater El árbol que recibe las llaves mayores que `key`.
+         * @return true si `key` estaba en el árbol.
+         */
+        bool split(int key, AVLTree& greater);
+
+        /**
+         * @brief Devuelve un iterador a la llave más pequeña del árbol, o `end()` si está vacío.
+         */
+        Iterator begin() const;
+
+        /**
+         * @brief Devuelve el iterador que sigue a la llave más grande del árbol.
+         */
+        Iterator end() const;
+
+        /**
+         * @brief Devuelve un iterador a la primera llave mayor o igual que `key`, en O(log n).
+         *
+         * @return El iterador, o `end()` si todas las llaves son menores que `key`.
+         */
+        Iterator lowerBound(int key) const;
+
+        /**
+         * @brief Devuelve un iterador a la primera llave estrictamente mayor que `key`, en O(log n).
+         *
+         * @return El iterador, o `end()` si ninguna llave es mayor que `key`.
+         */
+        Iterator upperBound(int key) const;
+
+        /**
+         * @brief Visita en orden ascendente las llaves del intervalo semiabierto [lo, hi).
+         *
+         * @effect Busca la primera llave con `lowerBound` y avanza por sucesores hasta llegar a
+         *         `hi`, en O(log n + k) para k llaves visitadas y sin reservar memoria.
+         *
+         * @require `visit` no debe insertar ni eliminar llaves del árbol.
+         *
+         * @param lo El límite inferior, incluido.
+         * @param hi El límite superior, excluido.
+         * @param visit Se llama con cada llave del intervalo.
+         */
+        template <typename Visitor>
+        void forEachInRange(int lo, int hi, Visitor visit) const {
+            for (Node* node = firstNotBelow(lo, false); node != nullptr && node->data < hi;
+                    node = successor(node)) {
+                visit(node->data);
+            }
+        }
+
+        /**
+         * @brief Cuenta las llaves del árbol menores que `key`, en O(log n).
+         *
+         * @require El árbol debe haberse construido con `ORDER_STATISTICS`.
+         *
+         * @throws std::logic_error si el árbol no usa `ORDER_STATISTICS`.
+         *
+         * @param key La llave de referencia, que no necesita estar en el árbol.
+         * @return La posición que `key` ocupa, o ocuparía, en el recorrido en orden.
+         */
+        int rank(int key);
+
+        /**
+         * @brief Devuelve la k-ésima llave más pequeña del árbol, en O(log n).
+         *
+         * @require El árbol debe haberse construido con `ORDER_STATISTICS`.
+         *
+         * @throws std::logic_error si el árbol no usa `ORDER_STATISTICS`.
+         * @throws std::out_of_range si `k` no está en [0, tamaño).
+         *
+         * @param k La posición en orden ascendente, empezando en 0.
+         * @return La llave en la posición `k`.
+         */
+        int select(int k);
+
+        /**
+         * @brief Cuenta las llaves del árbol que están en el intervalo cerrado [lo, hi], en O(log n).
+         *
+         * @require El árbol debe haberse construido con `ORDER_STATISTICS`.
+         *
+         * @throws std::logic_error si el árbol no usa `ORDER_STATISTICS`.
+         *
+         * @return La cantidad de llaves en el intervalo, 0 si `lo > hi`.
+         */
+        int countRange(int lo, int hi);
+
         /**
          * @brief Rebalancea el árbol AVL comenzando desde un nodo dado y subiendo hacia la raíz.
          *
@@ -166,7 +795,7 @@ class AVLTree : public Dict {
          * @param node El nodo del cual se desea conocer la altura.
          * @return Un entero que representa la altura del nodo. Retorna -1 si el nodo es nulo.
          */
-        int height(Node* node);
+        int height(const Node* node);
 
         /**
          * @brief Calcula el factor de balance de un nodo en el árbol AVL.
@@ -189,38 +818,56 @@ class AVLTree : public Dict {
          */
         int getBalance(Node* node);
 
-         /**
+        /**
          * @brief Devuelve una representación en forma de cadena del árbol binario.
          *
-         * @effect No modifica la estructura del árbol. Construye una cadena que contiene
-         *         información sobre el tamaño del árbol y los elementos presentes.
-         *
-         * @require El árbol debe estar inicializado. La función auxiliar `toString(Node*)`
-         *          debe existir y ser capaz de recorrer el árbol a partir de la raíz.
-         *
-         * @modifies No modifica ningún atributo del árbol. Solo construye y devuelve una cadena
-         *           de texto con la información del árbol.
+         * @effect No modifica la estructura del árbol. Es un envoltorio sobre `writeTo` que
+         *         junta en una cadena el tamaño del árbol y sus nodos en preorden.
          *
          * @return Una cadena de texto que incluye el tamaño del árbol y sus elementos.
          */
         std::string toString() override;
+
         /**
-         * @brief Devuelve una representación en forma de cadena de un nodo y sus hijos en el árbol binario.
-         *
-         * @effect No modifica la estructura del árbol. Genera una cadena de texto que representa
-         *         la información del nodo actual y sus hijos, de manera recursiva.
+         * @brief Devuelve una representación en forma de cadena de un nodo y sus descendientes.
          *
-         * @require El nodo `node` debe estar inicializado o ser nulo. Si no es nulo, debe tener accesibles
-         *          sus hijos izquierdos y derechos (si existen). Este método requiere que los valores de los
-         *          nodos sean convertibles a cadena mediante `std::to_string`.
+         * @effect No modifica la estructura del árbol. Es un envoltorio sobre `writeTo` que
+         *         junta en una cadena los nodos del subárbol en preorden, sin el tamaño.
          *
-         * @modifies No modifica la estructura del árbol ni ningún atributo de los nodos. 
-         *           Solo construye y devuelve una cadena de texto con la información de los nodos.
+         * @require El nodo `node` debe pertenecer al árbol o ser nulo.
          *
-         * @param node Un puntero al nodo del cual se quiere obtener la representación en cadena.
-         * @return Una cadena que describe el nodo actual, sus hijos (si tiene), y el resultado de las llamadas recursivas
-         *         sobre sus hijos izquierdo y derecho.
+         * @param node Un puntero a la raíz del subárbol que se quiere representar.
+         * @return Una cadena con una línea por nodo, o una cadena vacía si `node` es nulo.
          */
         std::string toString(Node* node);
 
+        /**
+         * @brief Escribe en `stream` lo mismo que devuelve `toString`, sin armar la cadena.
+         *
+         * @effect Recorre el árbol con una pila explícita y escribe por bloques, así que el
+         *         tiempo es lineal y la memoria no depende del tamaño del árbol.
+         *
+         * @return false si el flujo reportó un error.
+         */
+        bool writeTo(std::ostream& stream);
+
+        /**
+         * @brief Escribe en `file` lo mismo que devuelve `toString`, sin armar la cadena.
+         *
+         * @require `file` debe estar abierto para escritura.
+         *
+         * @return false si alguna escritura falló.
+         */
+        bool writeTo(FILE* file);
+
+        /**
+         * @brief Devuelve la memoria ocupada por los nodos del árbol.
+         *
+         * @effect Con `ARENA_NODES` reporta todo lo reservado por la arena, incluidos
+         *         los nodos libres; de lo contrario, el tamaño de los nodos vivos.
+         *
+         * @return La cantidad de bytes reservados para los nodos.
+         */
+        size_t memoryUsage() override;
+
 };
\ No newline at end of file
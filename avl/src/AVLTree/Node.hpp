@@ -1,3 +1,4 @@
+#pragma once
 /**
  * @struct Node
  * @brief Represents a node in an AVL tree.
@@ -15,11 +16,28 @@
  */
 struct Node{
     Node(int data)
-        : data(data), height(1), left(nullptr), right(nullptr), parent(nullptr) {
+        : data(data), height(0), left(nullptr), right(nullptr), parent(nullptr) {
           };
     int data;
     int height;
     Node *left;
     Node *right;
     Node *parent;
+};
+
+/**
+ * @struct RankedNode
+ * @brief A node that also keeps the size of its subtree.
+ *
+ * Only trees built with `AVLTree::ORDER_STATISTICS` create these nodes, so the
+ * other trees keep 32-byte nodes.
+ *
+ * @var RankedNode::count
+ * Number of nodes in the subtree rooted here.
+ */
+struct RankedNode : Node {
+    RankedNode(int data)
+        : Node(data), count(1) {
+          };
+    int count;
 };
\ No newline at end of file
@@ -0,0 +1,80 @@
+#include "NodeArena.hpp"
+#include <new>
+
+// Los bloques crecen al doble desde el minimo hasta el maximo
+static const size_t MIN_CHUNK_NODES = 256;
+static const size_t MAX_CHUNK_NODES = 65536;
+
+NodeArena::NodeArena(bool ranked)
+    : freeList(nullptr)
+    , cursor(nullptr)
+    , chunkEnd(nullptr)
+    , ranked(ranked)
+    , nodeBytes(ranked ? sizeof(RankedNode) : sizeof(Node))
+    , nextChunkNodes(MIN_CHUNK_NODES)
+    , carved(0) {
+}
+
+NodeArena::~NodeArena() {
+    clear();
+}
+
+void NodeArena::grow() {
+    // Pedir un bloque contiguo sin construir los nodos
+    char* chunk = static_cast<char*>(::operator new(nodeBytes * nextChunkNodes));
+    chunks.push_back(chunk);
+
+    cursor = chunk;
+    chunkEnd = chunk + nodeBytes * nextChunkNodes;
+    carved += nextChunkNodes;
+
+    if (nextChunkNodes < MAX_CHUNK_NODES) {
+        nextChunkNodes *= 2;
+    }
+}
+
+Node* NodeArena::allocate(int data) {
+    void* node;
+
+    if (freeList != nullptr) {
+        // Reciclar un nodo liberado
+        node = freeList;
+        freeList = freeList->left;
+    } else {
+        // Tomar el siguiente nodo sin usar del bloque actual
+        if (cursor == chunkEnd) {
+            this->grow();
+        }
+        node = cursor;
+        cursor += nodeBytes;
+    }
+
+    if (ranked) {
+        return new (node) RankedNode(data);
+    }
+    return new (node) Node(data);
+}
+
+void NodeArena::release(Node* node) {
+    // El hijo izquierdo se reutiliza como enlace de la lista libre
+    node->left = freeList;
+    freeList = node;
+}
+
+void NodeArena::clear() {
+    // Node no tiene destructor, basta con devolver los bloques completos
+    for (char* chunk : chunks) {
+        ::operator delete(chunk);
+    }
+    chunks.clear();
+
+    freeList = nullptr;
+    cursor = nullptr;
+    chunkEnd = nullptr;
+    nextChunkNodes = MIN_CHUNK_NODES;
+    carved = 0;
+}
+
+size_t NodeArena::bytesReserved() const {
+    return carved * nodeBytes;
+}
@@ -0,0 +1,87 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+#include "Node.hpp"
+
+/**
+ * @class NodeArena
+ * @brief A per-tree slab allocator for AVL tree nodes.
+ *
+ * Nodes are carved from large contiguous chunks instead of being requested one
+ * by one from the heap. Erased nodes are kept in a free list (linked through
+ * their `left` pointer) and recycled by later insertions, and `clear()` gives
+ * back every chunk at once without visiting the individual nodes. An arena hands
+ * out either plain `Node`s or `RankedNode`s, never both.
+ */
+class NodeArena {
+    private:
+        std::vector<char*> chunks; /// Chunks obtained from the heap, in allocation order.
+        Node* freeList;            /// Released nodes waiting to be recycled.
+        char* cursor;              /// Next never-used node of the current chunk.
+        char* chunkEnd;            /// One past the last node of the current chunk.
+        bool ranked;               /// Whether the nodes are `RankedNode`s.
+        size_t nodeBytes;          /// Bytes taken by each node.
+        size_t nextChunkNodes;     /// Number of nodes the next chunk will hold.
+        size_t carved;             /// Total number of nodes held by all chunks.
+
+        /**
+         * @brief Requests a new chunk from the heap and makes it the current one.
+         *
+         * @effect Chunks start small and double in size up to a fixed maximum, so
+         *         small trees do not pay for a large slab.
+         *
+         * @modifies `chunks`, `cursor`, `chunkEnd`, `nextChunkNodes` and `carved`.
+         */
+        void grow();
+
+    public:
+        /**
+         * @brief Constructs an empty arena. No memory is requested until the first allocation.
+         *
+         * @param ranked Whether to hand out `RankedNode`s instead of plain `Node`s.
+         */
+        explicit NodeArena(bool ranked = false);
+
+        /**
+         * @brief Releases every chunk owned by the arena.
+         */
+        ~NodeArena();
+
+        NodeArena(const NodeArena&) = delete;
+        NodeArena& operator=(const NodeArena&) = delete;
+
+        /**
+         * @brief Constructs a new node holding `data`.
+         *
+         * @effect Reuses a node from the free list when possible; otherwise carves the
+         *         next node of the current chunk, growing the arena when it is exhausted.
+         *
+         * @modifies The free list or the current chunk.
+         *
+         * @param data The value stored in the new node.
+         * @return A pointer to the initialized node.
+         */
+        Node* allocate(int data);
+
+        /**
+         * @brief Returns a node to the arena so that a later `allocate` can reuse it.
+         *
+         * @require `node` must have been obtained from this arena and must no longer be
+         *          referenced by the tree.
+         *
+         * @modifies The free list.
+         */
+        void release(Node* node);
+
+        /**
+         * @brief Releases all chunks at once, invalidating every node handed out so far.
+         *
+         * @modifies Empties the arena; the next allocation starts a fresh chunk.
+         */
+        void clear();
+
+        /**
+         * @brief Returns the number of bytes currently reserved by the arena.
+         */
+        size_t bytesReserved() const;
+};
@@ -0,0 +1,545 @@
+#include "AdaptiveRadixTree.hpp"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <vector>
+#include "../Serialization/BufferedWriter.hpp"
+#include "../Simd/ByteMatch.hpp"
+
+AdaptiveRadixTree::AdaptiveRadixTree()
+    : root(0)
+    , size(0)
+    , nodeBytes(0) {
+}
+
+AdaptiveRadixTree::~AdaptiveRadixTree() {
+    clear(root);
+}
+
+uint32_t AdaptiveRadixTree::ordered(int key) {
+    return static_cast<uint32_t>(key) ^ 0x80000000u;
+}
+
+uint8_t AdaptiveRadixTree::keyByte(uint32_t orderedKey, int depth) {
+    return static_cast<uint8_t>(orderedKey >> (8 * (KEY_BYTES - 1 - depth)));
+}
+
+bool AdaptiveRadixTree::isLeaf(uintptr_t link) {
+    return (link & 1) != 0;
+}
+
+uintptr_t AdaptiveRadixTree::makeLeaf(int key) {
+    return (static_cast<uintptr_t>(static_cast<uint32_t>(key)) << 1) | 1;
+}
+
+int AdaptiveRadixTree::leafKey(uintptr_t link) {
+    return static_cast<int>(static_cast<uint32_t>(link >> 1));
+}
+
+AdaptiveRadixTree::ArtNode* AdaptiveRadixTree::asNode(uintptr_t link) {
+    return reinterpret_cast<ArtNode*>(link);
+}
+
+uintptr_t* AdaptiveRadixTree::findChild(ArtNode* node, uint8_t byte) {
+    switch (node->type) {
+        case NODE4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            for (int i = 0; i < node4->count; ++i) {
+                if (node4->keys[i] == byte) {
+                    return &node4->children[i];
+                }
+            }
+            return nullptr;
+        }
+        case NODE16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            // Los bytes sin usar son 0, así que la máscara descarta los que pasan de count
+            uint32_t mask = simd::matchByte(reinterpret_cast<const int8_t*>(node16->keys),
+                static_cast<int8_t>(byte)) & ((1u << node16->count) - 1);
+            return mask != 0 ? &node16->children[simd::lowestBit(mask)] : nullptr;
+        }
+        case NODE48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            uint8_t slot = node48->childIndex[byte];
+            return slot != 0 ? &node48->children[slot - 1] : nullptr;
+        }
+        case NODE256: {
+            Node256* node256 = static_cast<Node256*>(node);
+            return node256->children[byte] != 0 ? &node256->children[byte] : nullptr;
+        }
+    }
+    return nullptr;
+}
+
+AdaptiveRadixTree::ArtNode* AdaptiveRadixTree::createNode(NodeType type) {
+    switch (type) {
+        case NODE4:
+            nodeBytes += sizeof(Node4);
+            return new Node4();
+        case NODE16:
+            nodeBytes += sizeof(Node16);
+            return new Node16();
+        case NODE48:
+            nodeBytes += sizeof(Node48);
+            return new Node48();
+        case NODE256:
+            nodeBytes += sizeof(Node256);
+            return new Node256();
+    }
+    return nullptr;
+}
+
+void AdaptiveRadixTree::destroyNode(ArtNode* node) {
+    switch (node->type) {
+        case NODE4:
+            nodeBytes -= sizeof(Node4);
+            delete static_cast<Node4*>(node);
+            break;
+        case NODE16:
+            nodeBytes -= sizeof(Node16);
+            delete static_cast<Node16*>(node);
+            break;
+        case NODE48:
+            nodeBytes -= sizeof(Node48);
+            delete static_cast<Node48*>(node);
+            break;
+        case NODE256:
+            nodeBytes -= sizeof(Node256);
+            delete static_cast<Node256*>(node);
+            break;
+    }
+}
+
+AdaptiveRadixTree::ArtNode* AdaptiveRadixTree::grow(uintptr_t* ref, ArtNode* node) {
+    ArtNode* bigger = nullptr;
+    switch (node->type) {
+        case NODE4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            Node16* node16 = static_cast<Node16*>(createNode(NODE16));
+            std::copy(node4->keys, node4->keys + node4->count, node16->keys);
+            std::copy(node4->children, node4->children + node4->count, node16->children);
+            bigger = node16;
+            break;
+        }
+        case NODE16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            Node48* node48 = static_cast<Node48*>(createNode(NODE48));
+            for (int i = 0; i < node16->count; ++i) {
+                node48->childIndex[node16->keys[i]] = static_cast<uint8_t>(i + 1);
+                node48->children[i] = node16->children[i];
+            }
+            bigger = node48;
+            break;
+        }
+        case NODE48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            Node256* node256 = static_cast<Node256*>(createNode(NODE256));
+            for (int byte = 0; byte < 256; ++byte) {
+                if (node48->childIndex[byte] != 0) {
+                    node256->children[byte] = node48->children[node48->childIndex[byte] - 1];
+                }
+            }
+            bigger = node256;
+            break;
+        }
+        case NODE256:
+            return node; // un Node256 nunca está lleno: hay un lugar por byte
+    }
+
+    bigger->prefixLength = node->prefixLength;
+    bigger->count = node->count;
+    std::copy(node->prefix, node->prefix + MAX_PREFIX, bigger->prefix);
+    destroyNode(node);
+    *ref = reinterpret_cast<uintptr_t>(bigger);
+    return bigger;
+}
+
+void AdaptiveRadixTree::shrink(uintptr_t* ref, ArtNode* node) {
+    ArtNode* smaller = nullptr;
+    switch (node->type) {
+        case NODE4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            uintptr_t child = node4->children[0];
+            if (!isLeaf(child)) {
+                // El hijo queda donde estaba el padre: su prefijo suma el del padre y el byte
+                ArtNode* inner = asNode(child);
+                uint8_t merged[MAX_PREFIX];
+                int length = 0;
+                for (int i = 0; i < node->prefixLength; ++i) {
+                    merged[length++] = node->prefix[i];
+                }
+                merged[length++] = node4->keys[0];
+                for (int i = 0; i < inner->prefixLength; ++i) {
+                    merged[length++] = inner->prefix[i];
+                }
+                std::copy(merged, merged + length, inner->prefix);
+                inner->prefixLength = static_cast<uint8_t>(length);
+            }
+            destroyNode(node);
+            *ref = child;
+            return;
+        }
+        case NODE16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            Node4* node4 = static_cast<Node4*>(createNode(NODE4));
+            std::copy(node16->keys, node16->keys + node16->count, node4->keys);
+            std::copy(node16->children, node16->children + node16->count, node4->children);
+            smaller = node4;
+            break;
+        }
+        case NODE48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            Node16* node16 = static_cast<Node16*>(createNode(NODE16));
+            int slot = 0;
+            for (int byte = 0; byte < 256; ++byte) {
+                if (node48->childIndex[byte] != 0) {
+                    node16->keys[slot] = static_cast<uint8_t>(byte);
+                    node16->children[slot] = node48->children[node48->childIndex[byte] - 1];
+                    slot++;
+                }
+            }
+            smaller = node16;
+            break;
+        }
+        case NODE256: {
+            Node256* node256 = static_cast<Node256*>(node);
+            Node48* node48 = static_cast<Node48*>(createNode(NODE48));
+            int slot = 0;
+            for (int byte = 0; byte < 256; ++byte) {
+                if (node256->children[byte] != 0) {
+                    node48->childIndex[byte] = static_cast<uint8_t>(slot + 1);
+                    node48->children[slot] = node256->children[byte];
+                    slot++;
+                }
+            }
+            smaller = node48;
+            break;
+        }
+    }
+
+    smaller->prefixLength = node->prefixLength;
+    smaller->count = node->count;
+    std::copy(node->prefix, node->prefix + MAX_PREFIX, smaller->prefix);
+    destroyNode(node);
+    *ref = reinterpret_cast<uintptr_t>(smaller);
+}
+
+void AdaptiveRadixTree::addChild(uintptr_t* ref, ArtNode* node, uint8_t byte, uintptr_t child) {
+    const int capacity[] = {4, 16, 48, 256};
+    if (node->count == capacity[node->type]) {
+        node = grow(ref, node);
+    }
+
+    switch (node->type) {
+        case NODE4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            int position = 0;
+            while (position < node4->count && node4->keys[position] < byte) {
+                position++;
+            }
+            std::copy_backward(node4->keys + position, node4->keys + node4->count,
+                node4->keys + node4->count + 1);
+            std::copy_backward(node4->children + position, node4->children + node4->count,
+                node4->children + node4->count + 1);
+            node4->keys[position] = byte;
+            node4->children[position] = child;
+            break;
+        }
+        case NODE16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            int position = static_cast<int>(
+                std::lower_bound(node16->keys, node16->keys + node16->count, byte) - node16->keys);
+            std::copy_backward(node16->keys + position, node16->keys + node16->count,
+                node16->keys + node16->count + 1);
+            std::copy_backward(node16->children + position, node16->children + node16->count,
+                node16->children + node16->count + 1);
+            node16->keys[position] = byte;
+            node16->children[position] = child;
+            break;
+        }
+        case NODE48: {
+            // Los borrados dejan huecos en cualquier lugar, así que se busca el primero libre
+            Node48* node48 = static_cast<Node48*>(node);
+            int slot = 0;
+            while (node48->children[slot] != 0) {
+                slot++;
+            }
+            node48->children[slot] = child;
+            node48->childIndex[byte] = static_cast<uint8_t>(slot + 1);
+            break;
+        }
+        case NODE256:
+            static_cast<Node256*>(node)->children[byte] = child;
+            break;
+    }
+    node->count++;
+}
+
+void AdaptiveRadixTree::removeChild(uintptr_t* ref, ArtNode* node, uint8_t byte) {
+    switch (node->type) {
+        case NODE4: {
+            Node4* node4 = static_cast<Node4*>(node);
+            int position = 0;
+            while (node4->keys[position] != byte) {
+                position++;
+            }
+            std::copy(node4->keys + position + 1, node4->keys + node4->count,
+                node4->keys + position);
+            std::copy(node4->children + position + 1, node4->children + node4->count,
+                node4->children + position);
+            node4->count--;
+            node4->keys[node4->count] = 0;
+            node4->children[node4->count] = 0;
+            break;
+        }
+        case NODE16: {
+            Node16* node16 = static_cast<Node16*>(node);
+            int position = 0;
+            while (node16->keys[position] != byte) {
+                position++;
+            }
+            std::copy(node16->keys + position + 1, node16->keys + node16->count,
+                node16->keys + position);
+            std::copy(node16->children + position + 1, node16->children + node16->count,
+                node16->children + position);
+            node16->count--;
+            node16->keys[node16->count] = 0;
+            node16->children[node16->count] = 0;
+            break;
+        }
+        case NODE48: {
+            Node48* node48 = static_cast<Node48*>(node);
+            node48->children[node48->childIndex[byte] - 1] = 0;
+            node48->childIndex[byte] = 0;
+            node48->count--;
+            break;
+        }
+        case NODE256:
+            static_cast<Node256*>(node)->children[byte] = 0;
+            node->count--;
+            break;
+    }
+
+    // Se achica por debajo del tamaño anterior, no al llegar a él, para que insertar y
+    // borrar alrededor del límite no cambie el tipo en cada operación
+    const int shrinkAt[] = {1, 3, 12, 37};
+    if (node->count == shrinkAt[node->type]) {
+        shrink(ref, node);
+    }
+}
+
+void AdaptiveRadixTree::insert(int element) {
+    const uint32_t key = ordered(element);
+    uintptr_t* ref = &root;
+    int depth = 0;
+
+    while (true) {
+        uintptr_t link = *ref;
+        if (link == 0) {
+            *ref = makeLeaf(element);
+            size++;
+            return;
+        }
+
+        if (isLeaf(link)) {
+            const uint32_t other = ordered(leafKey(link));
+            if (other == key) {
+                return; // element already exists in the tree
+            }
+            // Expansión perezosa: el nodo nuevo guarda como prefijo los bytes comunes
+            Node4* node = static_cast<Node4*>(createNode(NODE4));
+            int split = depth;
+            while (keyByte(key, split) == keyByte(other, split)) {
+                node->prefix[split - depth] = keyByte(key, split);
+                split++;
+            }
+            node->prefixLength = static_cast<uint8_t>(split - depth);
+            *ref = reinterpret_cast<uintptr_t>(node);
+            addChild(ref, node, keyByte(other, split), link);
+            addChild(ref, node, keyByte(key, split), makeLeaf(element));
+            size++;
+            return;
+        }
+
+        ArtNode* node = asNode(link);
+        int matched = 0;
+        while (matched < node->prefixLength
+                && node->prefix[matched] == keyByte(key, depth + matched)) {
+            matched++;
+        }
+        if (matched < node->prefixLength) {
+            // El prefijo se parte donde difiere: el nodo cuelga del byte que no coincidió
+            Node4* parent = static_cast<Node4*>(createNode(NODE4));
+            std::copy(node->prefix, node->prefix + matched, parent->prefix);
+            parent->prefixLength = static_cast<uint8_t>(matched);
+
+            const uint8_t nodeByte = node->prefix[matched];
+            const int rest = node->prefixLength - matched - 1;
+            std::copy(node->prefix + matched + 1, node->prefix + matched + 1 + rest, node->prefix);
+            node->prefixLength = static_cast<uint8_t>(rest);
+
+            *ref = reinterpret_cast<uintptr_t>(parent);
+            addChild(ref, parent, nodeByte, link);
+            addChild(ref, parent, keyByte(key, depth + matched), makeLeaf(element));
+            size++;
+            return;
+        }
+
+        depth += node->prefixLength;
+        const uint8_t byte = keyByte(key, depth);
+        uintptr_t* child = findChild(node, byte);
+        if (child == nullptr) {
+            addChild(ref, node, byte, makeLeaf(element));
+            size++;
+            return;
+        }
+        ref = child;
+        depth++;
+    }
+}
+
+bool AdaptiveRadixTree::contains(int element) {
+    return find(root, element);
+}
+
+bool AdaptiveRadixTree::find(uintptr_t link, int element) {
+    const uint32_t key = ordered(element);
+    int depth = 0;
+
+    // Búsqueda optimista: la hoja guarda la llave completa, así que los prefijos se
+    // saltan sin compararlos y solo se compara la llave al final
+    while (link != 0 && !isLeaf(link)) {
+        ArtNode* node = asNode(link);
+        depth += node->prefixLength;
+        uintptr_t* child = findChild(node, keyByte(key, depth));
+        if (child == nullptr) {
+            return false;
+        }
+        link = *child;
+        depth++;
+    }
+    return link != 0 && leafKey(link) == element;
+}
+
+void AdaptiveRadixTree::erase(int element) {
+    const uint32_t key = ordered(element);
+    uintptr_t* parentRef = nullptr;
+    uintptr_t* ref = &root;
+    uint8_t byte = 0;
+    int depth = 0;
+
+    while (*ref != 0 && !isLeaf(*ref)) {
+        ArtNode* node = asNode(*ref);
+        depth += node->prefixLength;
+        byte = keyByte(key, depth);
+        uintptr_t* child = findChild(node, byte);
+        if (child == nullptr) {
+            return;
+        }
+        parentRef = ref;
+        ref = child;
+        depth++;
+    }
+    if (*ref == 0 || leafKey(*ref) != element) {
+        return;
+    }
+
+    if (parentRef == nullptr) {
+        root = 0;
+    } else {
+        removeChild(parentRef, asNode(*parentRef), byte);
+    }
+    size--;
+}
+
+void AdaptiveRadixTree::clear(uintptr_t link) {
+    if (link == 0 || isLeaf(link)) {
+        return;
+    }
+    ArtNode* node = asNode(link);
+    forEachChild(node, [this](uint8_t, uintptr_t child) {
+        clear(child);
+    });
+    destroyNode(node);
+}
+
+void AdaptiveRadixTree::clear() {
+    clear(root);
+    root = 0;
+    size = 0;
+}
+
+size_t AdaptiveRadixTree::count() const {
+    return size;
+}
+
+bool AdaptiveRadixTree::forEachElement(const std::function<void(int)>& visit) {
+    forEachInRange(INT_MIN, INT_MAX, visit);
+    // El intervalo es semiabierto, así que INT_MAX se busca aparte
+    if (find(root, INT_MAX)) {
+        visit(INT_MAX);
+    }
+    return true;
+}
+
+std::string AdaptiveRadixTree::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer);
+    }
+    return stream.str();
+}
+
+void AdaptiveRadixTree::writeTo(BufferedWriter& writer) const {
+    size_t nodes[4] = {0, 0, 0, 0};
+    std::vector<uintptr_t> pending;
+    if (root != 0) {
+        pending.push_back(root);
+    }
+    while (!pending.empty()) {
+        uintptr_t link = pending.back();
+        pending.pop_back();
+        if (isLeaf(link)) {
+            continue;
+        }
+        const ArtNode* node = asNode(link);
+        nodes[node->type]++;
+        forEachChild(node, [&pending](uint8_t, uintptr_t child) {
+            pending.push_back(child);
+        });
+    }
+
+    writer.write("Size: ");
+    writer.write(static_cast<int>(size));
+    writer.write("\nNodes: Node4 ");
+    writer.write(static_cast<int>(nodes[NODE4]));
+    writer.write(", Node16 ");
+    writer.write(static_cast<int>(nodes[NODE16]));
+    writer.write(", Node48 ");
+    writer.write(static_cast<int>(nodes[NODE48]));
+    writer.write(", Node256 ");
+    writer.write(static_cast<int>(nodes[NODE256]));
+    writer.write("\nElements:\n");
+
+    bool first = true;
+    forEachInRange(INT_MIN, INT_MAX, [&](int key) {
+        if (!first) {
+            writer.write(" ");
+        }
+        writer.write(key);
+        first = false;
+    });
+    // El intervalo es semiabierto, así que INT_MAX se busca aparte
+    if (find(root, INT_MAX)) {
+        if (!first) {
+            writer.write(" ");
+        }
+        writer.write(INT_MAX);
+    }
+    writer.write("\n");
+}
+
+size_t AdaptiveRadixTree::memoryUsage() {
+    return nodeBytes;
+}
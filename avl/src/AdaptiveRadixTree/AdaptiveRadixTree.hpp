@@ -0,0 +1,333 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../Dict/Dict.h"
+
+class BufferedWriter;
+
+/**
+ * @class AdaptiveRadixTree
+ * @brief An adaptive radix tree (Leis et al.) over the four bytes of each `int` key.
+ *
+ * A key is flipped in its sign bit so that unsigned byte order matches `int` order, and
+ * each level of the tree consumes one of its bytes, most significant first. There are at
+ * most four levels, so every operation costs O(4) steps whatever the number of keys, and
+ * an in-order walk yields the keys sorted.
+ *
+ * Inner nodes come in four sizes and grow or shrink as children come and go: `Node4` and
+ * `Node16` keep sorted key bytes next to their children (`Node16` is searched with one
+ * SSE2 compare, see `simd::matchByte`), `Node48` maps every byte to one of 48 slots, and
+ * `Node256` is indexed directly by the byte.
+ *
+ * Two techniques keep the tree short. Path compression: a node stores the bytes that all
+ * of its keys share below its parent (at most 3) instead of a chain of one-child nodes.
+ * Lazy expansion: a subtree with a single key is just a leaf. Because the key fits in a
+ * pointer, a leaf is not allocated at all; it is the key itself, shifted left and tagged
+ * with a 1 in the low bit, stored in the child slot.
+ */
+class AdaptiveRadixTree : public Dict {
+    protected:
+        static_assert(sizeof(uintptr_t) >= 8, "leaves store the 32-bit key inside a tagged pointer");
+
+        /// Bytes of a key, one per level.
+        static const int KEY_BYTES = 4;
+        /// A node below the root consumes at least one byte, so no prefix is longer than this.
+        static const int MAX_PREFIX = KEY_BYTES - 1;
+
+        /// Node layouts, from the smallest to the largest.
+        enum NodeType : uint8_t {
+            NODE4,
+            NODE16,
+            NODE48,
+            NODE256
+        };
+
+        /**
+         * @struct ArtNode
+         * @brief Header common to the four node types.
+         */
+        struct ArtNode {
+            explicit ArtNode(NodeType type)
+            : type(type)
+            , prefixLength(0)
+            , count(0)
+            , prefix() {
+            };
+
+            NodeType type;              /// Which of the four layouts follows the header.
+            uint8_t prefixLength;       /// Bytes of `prefix` in use.
+            uint16_t count;             /// Number of children.
+            uint8_t prefix[MAX_PREFIX]; /// Bytes shared by every key below the node.
+        };
+
+        /// Up to 4 children with their key bytes, sorted.
+        struct Node4 : ArtNode {
+            Node4() : ArtNode(NODE4), keys(), children() {};
+            uint8_t keys[4];
+            uintptr_t children[4];
+        };
+
+        /// Up to 16 children with their key bytes, sorted and compared all at once.
+        struct Node16 : ArtNode {
+            Node16() : ArtNode(NODE16), keys(), children() {};
+            uint8_t keys[16];
+            uintptr_t children[16];
+        };
+
+        /// Up to 48 children; `childIndex[byte]` is the slot plus one, or 0.
+        struct Node48 : ArtNode {
+            Node48() : ArtNode(NODE48), childIndex(), children() {};
+            uint8_t childIndex[256];
+            uintptr_t children[48];
+        };
+
+        /// One child slot per byte value.
+        struct Node256 : ArtNode {
+            Node256() : ArtNode(NODE256), children() {};
+            uintptr_t children[256];
+        };
+
+        uintptr_t root;   /// A tagged leaf, an inner node, or 0 if the tree is empty.
+        size_t size;      /// Number of keys.
+        size_t nodeBytes; /// Bytes held by inner nodes, for `memoryUsage`.
+
+        /**
+         * @brief Devuelve la llave con el bit de signo invertido, cuyo orden sin signo es el de `int`.
+         */
+        static uint32_t ordered(int key);
+
+        /**
+         * @brief Devuelve el byte de la llave ordenada que consume el nivel `depth`.
+         */
+        static uint8_t keyByte(uint32_t orderedKey, int depth);
+
+        static bool isLeaf(uintptr_t link);
+        static uintptr_t makeLeaf(int key);
+        static int leafKey(uintptr_t link);
+        static ArtNode* asNode(uintptr_t link);
+
+        /**
+         * @brief Devuelve el lugar del hijo de `byte`, o nullptr si el nodo no lo tiene.
+         */
+        static uintptr_t* findChild(ArtNode* node, uint8_t byte);
+
+        /**
+         * @brief Verifica si la llave está en el árbol cuya raíz es `link`.
+         */
+        static bool find(uintptr_t link, int element);
+
+        /**
+         * @brief Reserva un nodo del tipo dado y suma su tamaño a `nodeBytes`.
+         */
+        ArtNode* createNode(NodeType type);
+
+        /**
+         * @brief Libera un nodo sin tocar sus hijos y resta su tamaño de `nodeBytes`.
+         */
+        void destroyNode(ArtNode* node);
+
+        /**
+         * @brief Reemplaza un nodo lleno por uno del tipo siguiente con los mismos hijos.
+         *
+         * @param ref El enlace que apunta al nodo, que pasa a apuntar al nuevo.
+         * @return El nodo nuevo.
+         */
+        ArtNode* grow(uintptr_t* ref, ArtNode* node);
+
+        /**
+         * @brief Reemplaza un nodo con pocos hijos por uno del tipo anterior, o lo quita si
+         *        le queda un solo hijo.
+         *
+         * @effect Un `Node4` con un hijo se reemplaza por ese hijo; si el hijo es un nodo
+         *         interno, hereda el prefijo del padre y el byte que los unía.
+         *
+         * @param ref El enlace que apunta al nodo.
+         */
+        void shrink(uintptr_t* ref, ArtNode* node);
+
+        /**
+         * @brief Agrega el hijo `child` con el byte `byte`, creciendo el nodo si está lleno.
+         *
+         * @require El nodo no debe tener ya un hijo con ese byte.
+         */
+        void addChild(uintptr_t* ref, ArtNode* node, uint8_t byte, uintptr_t child);
+
+        /**
+         * @brief Quita el hijo de `byte` y achica el nodo si le quedan pocos.
+         */
+        void removeChild(uintptr_t* ref, ArtNode* node, uint8_t byte);
+
+        /**
+         * @brief Libera todos los nodos internos de un subárbol.
+         */
+        void clear(uintptr_t link);
+
+        /**
+         * @brief Llama a `visit(byte, child)` con cada hijo del nodo en orden de byte.
+         */
+        template <typename Function>
+        static void forEachChild(const ArtNode* node, Function visit) {
+            switch (node->type) {
+                case NODE4: {
+                    const Node4* node4 = static_cast<const Node4*>(node);
+                    for (int i = 0; i < node4->count; ++i) {
+                        visit(node4->keys[i], node4->children[i]);
+                    }
+                    break;
+                }
+                case NODE16: {
+                    const Node16* node16 = static_cast<const Node16*>(node);
+                    for (int i = 0; i < node16->count; ++i) {
+                        visit(node16->keys[i], node16->children[i]);
+                    }
+                    break;
+                }
+                case NODE48: {
+                    const Node48* node48 = static_cast<const Node48*>(node);
+                    for (int byte = 0; byte < 256; ++byte) {
+                        if (node48->childIndex[byte] != 0) {
+                            visit(static_cast<uint8_t>(byte),
+                                node48->children[node48->childIndex[byte] - 1]);
+                        }
+                    }
+                    break;
+                }
+                case NODE256: {
+                    const Node256* node256 = static_cast<const Node256*>(node);
+                    for (int byte = 0; byte < 256; ++byte) {
+                        if (node256->children[byte] != 0) {
+                            visit(static_cast<uint8_t>(byte), node256->children[byte]);
+                        }
+                    }
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief Visita en orden las llaves del subárbol que caen en [lo, hi), saltando los
+         *        subárboles que quedan completos fuera del intervalo.
+         *
+         * @param depth El nivel del byte que consume el enlace.
+         * @param path Los bytes de la llave ordenada ya consumidos, en su posición.
+         * @param lo El límite inferior ordenado, incluido.
+         * @param hi El límite superior ordenado, excluido.
+         */
+        template <typename Visitor>
+        static void visitRange(uintptr_t link, int depth, uint32_t path, uint32_t lo,
+                uint32_t hi, Visitor& visit) {
+            if (isLeaf(link)) {
+                uint32_t key = ordered(leafKey(link));
+                if (key >= lo && key < hi) {
+                    visit(leafKey(link));
+                }
+                return;
+            }
+
+            const ArtNode* node = asNode(link);
+            for (int i = 0; i < node->prefixLength; ++i) {
+                path |= static_cast<uint32_t>(node->prefix[i]) << (8 * (KEY_BYTES - 1 - depth - i));
+            }
+            depth += node->prefixLength;
+
+            // Las llaves del subárbol comparten los bytes ya consumidos; el resto es libre
+            uint32_t free = 0xFFFFFFFFu >> (8 * depth);
+            if ((path | free) < lo || path >= hi) {
+                return;
+            }
+            const int shift = 8 * (KEY_BYTES - 1 - depth);
+            forEachChild(node, [&](uint8_t byte, uintptr_t child) {
+                visitRange(child, depth + 1, path | static_cast<uint32_t>(byte) << shift,
+                    lo, hi, visit);
+            });
+        }
+
+        /**
+         * @brief Escribe el tamaño, la cantidad de nodos de cada tipo y las llaves en orden.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+    public:
+        /**
+         * @brief Constructs an empty tree.
+         */
+        AdaptiveRadixTree();
+
+        AdaptiveRadixTree(const AdaptiveRadixTree&) = delete;
+        AdaptiveRadixTree& operator=(const AdaptiveRadixTree&) = delete;
+
+        /**
+         * @brief Deletes every node of the tree.
+         */
+        ~AdaptiveRadixTree();
+
+        /**
+         * @brief Inserta un elemento bajando un nivel por byte.
+         *
+         * @effect Un enlace vacío recibe la hoja; una hoja con otra llave se expande en un
+         *         `Node4` con el prefijo que ambas comparten; un prefijo que no coincide se
+         *         parte con un `Node4` nuevo en el byte donde difieren.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en el árbol en a lo sumo cuatro niveles.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el árbol, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento y achica o quita los nodos que quedan con pocos hijos.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Removes every key from the tree.
+         */
+        void clear();
+
+        /**
+         * @brief Devuelve la cantidad de llaves del árbol.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol en orden ascendente.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Llama a `visit` con cada llave de [lo, hi) en orden ascendente.
+         *
+         * @require `visit` no debe insertar ni eliminar llaves del árbol.
+         *
+         * @param lo El límite inferior, incluido.
+         * @param hi El límite superior, excluido.
+         * @param visit Se llama con cada llave del intervalo.
+         */
+        template <typename Visitor>
+        void forEachInRange(int lo, int hi, Visitor visit) const {
+            if (root != 0 && lo < hi) {
+                visitRange(root, 0, 0, ordered(lo), ordered(hi), visit);
+            }
+        }
+
+        /**
+         * @brief Devuelve el tamaño, los nodos de cada tipo y las llaves en orden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes de los nodos internos; las hojas no ocupan memoria aparte.
+         */
+        size_t memoryUsage() override;
+};
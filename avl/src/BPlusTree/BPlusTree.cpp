@@ -0,0 +1,391 @@
+#include "BPlusTree.hpp"
+#include <algorithm>
+#include <climits>
+#include <sstream>
+#include <vector>
+#include "../Serialization/BufferedWriter.hpp"
+#include "../Simd/KeySearch.hpp"
+
+BPlusTree::BPlusNode::BPlusNode(bool leaf)
+    : count(0)
+    , leaf(leaf)
+    , next(nullptr) {
+    std::fill(keys, keys + NODE_KEYS, INT_MAX);
+}
+
+BPlusTree::InnerNode::InnerNode()
+    : BPlusNode(false)
+    , children() {
+}
+
+BPlusTree::BPlusTree()
+    : root(nullptr)
+    , size(0)
+    , leafCount(0)
+    , innerCount(0) {
+}
+
+BPlusTree::~BPlusTree() {
+    clear(root);
+}
+
+BPlusTree::InnerNode* BPlusTree::asInner(BPlusNode* node) {
+    return static_cast<InnerNode*>(node);
+}
+
+int BPlusTree::lowerBound(const BPlusNode* node, int key) {
+    return static_cast<int>(simd::countLess<NODE_KEYS>(node->keys, key));
+}
+
+int BPlusTree::childIndex(const InnerNode* node, int key) {
+    // Con key == INT_MAX el relleno también cuenta; el hijo nunca pasa de `count`
+    int index = static_cast<int>(simd::countNotGreater<NODE_KEYS>(node->keys, key));
+    return std::min(index, node->count);
+}
+
+const BPlusTree::BPlusNode* BPlusTree::findLeaf(int key) const {
+    const BPlusNode* node = root;
+    while (node != nullptr && !node->leaf) {
+        const InnerNode* inner = static_cast<const InnerNode*>(node);
+        node = inner->children[childIndex(inner, key)];
+    }
+    return node;
+}
+
+void BPlusTree::insertKey(BPlusNode* node, int position, int key) {
+    std::copy_backward(node->keys + position, node->keys + node->count,
+        node->keys + node->count + 1);
+    node->keys[position] = key;
+    node->count++;
+}
+
+void BPlusTree::removeKey(BPlusNode* node, int position) {
+    std::copy(node->keys + position + 1, node->keys + node->count, node->keys + position);
+    node->count--;
+    node->keys[node->count] = INT_MAX;
+}
+
+void BPlusTree::removeChild(InnerNode* parent, int index) {
+    std::copy(parent->children + index + 2, parent->children + parent->count + 1,
+        parent->children + index + 1);
+    removeKey(parent, index);
+}
+
+BPlusTree::BPlusNode* BPlusTree::splitLeaf(BPlusNode* leaf, int position, int key) {
+    // Juntar las 33 llaves en orden y dejar 17 a la izquierda y 16 a la derecha
+    int merged[NODE_KEYS + 1];
+    std::copy(leaf->keys, leaf->keys + position, merged);
+    merged[position] = key;
+    std::copy(leaf->keys + position, leaf->keys + NODE_KEYS, merged + position + 1);
+
+    const int leftCount = (NODE_KEYS + 2) / 2;
+    BPlusNode* right = new BPlusNode(true);
+    leafCount++;
+    std::copy(merged, merged + leftCount, leaf->keys);
+    std::fill(leaf->keys + leftCount, leaf->keys + NODE_KEYS, INT_MAX);
+    leaf->count = leftCount;
+    std::copy(merged + leftCount, merged + NODE_KEYS + 1, right->keys);
+    right->count = NODE_KEYS + 1 - leftCount;
+
+    right->next = leaf->next;
+    leaf->next = right;
+    return right;
+}
+
+BPlusTree::InnerNode* BPlusTree::splitInner(InnerNode* node, int index, int& separator,
+        BPlusNode* child) {
+    // 33 separadores y 34 hijos: 16 separadores por lado y el del medio sube
+    int keys[NODE_KEYS + 1];
+    BPlusNode* children[NODE_KEYS + 2];
+    std::copy(node->keys, node->keys + index, keys);
+    keys[index] = separator;
+    std::copy(node->keys + index, node->keys + NODE_KEYS, keys + index + 1);
+    std::copy(node->children, node->children + index + 1, children);
+    children[index + 1] = child;
+    std::copy(node->children + index + 1, node->children + NODE_KEYS + 1, children + index + 2);
+
+    const int leftCount = NODE_KEYS / 2;
+    InnerNode* right = new InnerNode();
+    innerCount++;
+    std::copy(keys, keys + leftCount, node->keys);
+    std::fill(node->keys + leftCount, node->keys + NODE_KEYS, INT_MAX);
+    std::copy(children, children + leftCount + 1, node->children);
+    node->count = leftCount;
+
+    separator = keys[leftCount];
+    right->count = NODE_KEYS - leftCount;
+    std::copy(keys + leftCount + 1, keys + NODE_KEYS + 1, right->keys);
+    std::copy(children + leftCount + 1, children + NODE_KEYS + 2, right->children);
+    return right;
+}
+
+void BPlusTree::insert(int element) {
+    if (root == nullptr) {
+        root = new BPlusNode(true);
+        leafCount++;
+    }
+
+    // Recordar el camino para subir los separadores de las divisiones
+    InnerNode* path[MAX_DEPTH];
+    int indices[MAX_DEPTH];
+    int depth = 0;
+    BPlusNode* node = root;
+    while (!node->leaf) {
+        InnerNode* inner = asInner(node);
+        int index = childIndex(inner, element);
+        path[depth] = inner;
+        indices[depth++] = index;
+        node = inner->children[index];
+    }
+
+    int position = lowerBound(node, element);
+    if (position < node->count && node->keys[position] == element) {
+        return; // element already exists in the tree
+    }
+    size++;
+    if (node->count < NODE_KEYS) {
+        insertKey(node, position, element);
+        return;
+    }
+
+    BPlusNode* child = splitLeaf(node, position, element);
+    int separator = child->keys[0];
+    while (depth > 0) {
+        InnerNode* parent = path[--depth];
+        int index = indices[depth];
+        if (parent->count < NODE_KEYS) {
+            std::copy_backward(parent->children + index + 1,
+                parent->children + parent->count + 1, parent->children + parent->count + 2);
+            parent->children[index + 1] = child;
+            insertKey(parent, index, separator);
+            return;
+        }
+        child = splitInner(parent, index, separator, child);
+    }
+
+    // La raíz se dividió: el árbol crece un nivel
+    InnerNode* newRoot = new InnerNode();
+    innerCount++;
+    newRoot->keys[0] = separator;
+    newRoot->count = 1;
+    newRoot->children[0] = root;
+    newRoot->children[1] = child;
+    root = newRoot;
+}
+
+bool BPlusTree::contains(int element) {
+    const BPlusNode* leaf = findLeaf(element);
+    if (leaf == nullptr) {
+        return false;
+    }
+    int position = lowerBound(leaf, element);
+    return position < leaf->count && leaf->keys[position] == element;
+}
+
+void BPlusTree::erase(int element) {
+    if (root == nullptr) {
+        return;
+    }
+
+    InnerNode* path[MAX_DEPTH];
+    int indices[MAX_DEPTH];
+    int depth = 0;
+    BPlusNode* node = root;
+    while (!node->leaf) {
+        InnerNode* inner = asInner(node);
+        int index = childIndex(inner, element);
+        path[depth] = inner;
+        indices[depth++] = index;
+        node = inner->children[index];
+    }
+
+    int position = lowerBound(node, element);
+    if (position >= node->count || node->keys[position] != element) {
+        return;
+    }
+    removeKey(node, position);
+    size--;
+
+    // Subir mientras el nodo reparado deje a su padre con menos de la mitad
+    while (depth > 0 && node->count < MIN_KEYS) {
+        InnerNode* parent = path[--depth];
+        rebalanceChild(parent, indices[depth]);
+        node = parent;
+    }
+
+    if (root->count == 0) {
+        if (root->leaf) {
+            delete root;
+            root = nullptr;
+            leafCount--;
+        } else {
+            // La raíz interna se quedó sin separadores: su único hijo la reemplaza
+            InnerNode* old = asInner(root);
+            root = old->children[0];
+            delete old;
+            innerCount--;
+        }
+    }
+}
+
+void BPlusTree::rebalanceChild(InnerNode* parent, int index) {
+    BPlusNode* node = parent->children[index];
+
+    if (index > 0) {
+        BPlusNode* left = parent->children[index - 1];
+        if (left->count > MIN_KEYS) {
+            // Pasar la última llave del hermano izquierdo
+            if (node->leaf) {
+                insertKey(node, 0, left->keys[left->count - 1]);
+                parent->keys[index - 1] = node->keys[0];
+            } else {
+                InnerNode* inner = asInner(node);
+                InnerNode* sibling = asInner(left);
+                std::copy_backward(inner->children, inner->children + inner->count + 1,
+                    inner->children + inner->count + 2);
+                inner->children[0] = sibling->children[sibling->count];
+                insertKey(inner, 0, parent->keys[index - 1]);
+                parent->keys[index - 1] = sibling->keys[sibling->count - 1];
+            }
+            removeKey(left, left->count - 1);
+            return;
+        }
+    }
+
+    if (index < parent->count) {
+        BPlusNode* right = parent->children[index + 1];
+        if (right->count > MIN_KEYS) {
+            // Pasar la primera llave del hermano derecho
+            if (node->leaf) {
+                insertKey(node, node->count, right->keys[0]);
+                removeKey(right, 0);
+                parent->keys[index] = right->keys[0];
+            } else {
+                InnerNode* inner = asInner(node);
+                InnerNode* sibling = asInner(right);
+                insertKey(inner, inner->count, parent->keys[index]);
+                inner->children[inner->count] = sibling->children[0];
+                parent->keys[index] = sibling->keys[0];
+                std::copy(sibling->children + 1, sibling->children + sibling->count + 1,
+                    sibling->children);
+                removeKey(sibling, 0);
+            }
+            return;
+        }
+    }
+
+    // Ningún hermano tiene de sobra: fusionar con uno de ellos
+    mergeChildren(parent, index > 0 ? index - 1 : index);
+}
+
+void BPlusTree::mergeChildren(InnerNode* parent, int index) {
+    BPlusNode* left = parent->children[index];
+    BPlusNode* right = parent->children[index + 1];
+
+    if (left->leaf) {
+        std::copy(right->keys, right->keys + right->count, left->keys + left->count);
+        left->count += right->count;
+        left->next = right->next;
+        delete right;
+        leafCount--;
+    } else {
+        // El separador del padre baja entre las llaves de los dos nodos
+        InnerNode* inner = asInner(left);
+        InnerNode* sibling = asInner(right);
+        inner->keys[inner->count] = parent->keys[index];
+        std::copy(sibling->keys, sibling->keys + sibling->count, inner->keys + inner->count + 1);
+        std::copy(sibling->children, sibling->children + sibling->count + 1,
+            inner->children + inner->count + 1);
+        inner->count += 1 + sibling->count;
+        delete sibling;
+        innerCount--;
+    }
+    removeChild(parent, index);
+}
+
+void BPlusTree::clear(BPlusNode* node) {
+    if (node == nullptr) {
+        return;
+    }
+    if (node->leaf) {
+        delete node;
+        return;
+    }
+    InnerNode* inner = asInner(node);
+    for (int i = 0; i <= inner->count; ++i) {
+        clear(inner->children[i]);
+    }
+    delete inner;
+}
+
+void BPlusTree::clear() {
+    clear(root);
+    root = nullptr;
+    size = 0;
+    leafCount = 0;
+    innerCount = 0;
+}
+
+size_t BPlusTree::count() const {
+    return size;
+}
+
+bool BPlusTree::forEachElement(const std::function<void(int)>& visit) {
+    const BPlusNode* leaf = root;
+    while (leaf != nullptr && !leaf->leaf) {
+        leaf = static_cast<const InnerNode*>(leaf)->children[0];
+    }
+    for (; leaf != nullptr; leaf = leaf->next) {
+        for (int i = 0; i < leaf->count; ++i) {
+            visit(leaf->keys[i]);
+        }
+    }
+    return true;
+}
+
+std::string BPlusTree::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer);
+    }
+    return stream.str();
+}
+
+void BPlusTree::writeTo(BufferedWriter& writer) const {
+    writer.write("Size: ");
+    writer.write(static_cast<int>(size));
+    writer.write("\nElements:\n");
+
+    // Preorden con pila: los hijos se apilan de derecha a izquierda
+    std::vector<const BPlusNode*> pending;
+    if (root != nullptr) {
+        pending.push_back(root);
+    }
+    while (!pending.empty()) {
+        const BPlusNode* node = pending.back();
+        pending.pop_back();
+
+        if (node->leaf) {
+            writer.write("Leaf:");
+        } else {
+            writer.write("Inner:");
+        }
+        for (int i = 0; i < node->count; ++i) {
+            writer.write(" ");
+            writer.write(node->keys[i]);
+        }
+        writer.write("\n");
+
+        if (!node->leaf) {
+            const InnerNode* inner = static_cast<const InnerNode*>(node);
+            for (int i = inner->count; i >= 0; --i) {
+                pending.push_back(inner->children[i]);
+            }
+        }
+    }
+}
+
+size_t BPlusTree::memoryUsage() {
+    return leafCount * sizeof(BPlusNode) + innerCount * sizeof(InnerNode);
+}
@@ -0,0 +1,224 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "../Dict/Dict.h"
+
+class BufferedWriter;
+
+/**
+ * @class BPlusTree
+ * @brief A B+ tree of `int` keys whose nodes hold up to 32 keys in aligned blocks.
+ *
+ * All keys live in the leaves, which are linked left to right so a range scan walks them
+ * without going back up. Inner nodes only route: the child `i` holds the keys smaller
+ * than `keys[i]` and the child `i + 1` the keys greater or equal. One node takes a few
+ * cache lines instead of one line per key, and the position of a key inside a node is
+ * found by comparing the whole block at once with SIMD instructions (see
+ * `simd::countLess`), so a search costs about one miss per level with only
+ * log32(n) levels.
+ *
+ * Every node except the root keeps at least half of its keys: insertions split full nodes
+ * and deletions borrow from a sibling or merge with it. Unused key slots hold `INT_MAX`
+ * so the block compares never need the key count.
+ */
+class BPlusTree : public Dict {
+    protected:
+        /// Keys per node; two AVX2 vectors per cache line.
+        static const int NODE_KEYS = 32;
+        /// Minimum number of keys of every node except the root.
+        static const int MIN_KEYS = NODE_KEYS / 2;
+        /// Enough levels for any tree that fits in memory, with a fanout of at least 17.
+        static const int MAX_DEPTH = 16;
+
+        /**
+         * @struct BPlusNode
+         * @brief A leaf, or the common part of an inner node.
+         */
+        struct alignas(64) BPlusNode {
+            explicit BPlusNode(bool leaf);
+
+            int keys[NODE_KEYS];  /// Sorted keys, padded with INT_MAX.
+            int count;            /// Number of keys in use.
+            bool leaf;            /// Whether the node is a leaf.
+            BPlusNode* next;      /// Next leaf in key order; unused in inner nodes.
+        };
+
+        /**
+         * @struct InnerNode
+         * @brief A routing node with `count` separators and `count + 1` children.
+         */
+        struct InnerNode : BPlusNode {
+            InnerNode();
+
+            BPlusNode* children[NODE_KEYS + 1];
+        };
+
+        BPlusNode* root;    /// The root, a leaf while the tree is small; nullptr if empty.
+        size_t size;        /// Number of keys in the tree.
+        size_t leafCount;   /// Number of leaves, for `memoryUsage`.
+        size_t innerCount;  /// Number of inner nodes, for `memoryUsage`.
+
+        static InnerNode* asInner(BPlusNode* node);
+
+        /**
+         * @brief Devuelve la posición de la primera llave del nodo mayor o igual que `key`.
+         */
+        static int lowerBound(const BPlusNode* node, int key);
+
+        /**
+         * @brief Devuelve el hijo de un nodo interno por el que sigue la búsqueda de `key`.
+         */
+        static int childIndex(const InnerNode* node, int key);
+
+        /**
+         * @brief Devuelve la hoja donde está o debería estar `key`, o nullptr si el árbol está vacío.
+         */
+        const BPlusNode* findLeaf(int key) const;
+
+        /**
+         * @brief Inserta `key` en la posición `position` corriendo las siguientes.
+         *
+         * @require El nodo debe tener espacio libre.
+         */
+        static void insertKey(BPlusNode* node, int position, int key);
+
+        /**
+         * @brief Quita la llave de la posición `position` y rellena el hueco final con INT_MAX.
+         */
+        static void removeKey(BPlusNode* node, int position);
+
+        /**
+         * @brief Quita el separador `index` de `parent` y el hijo que está a su derecha.
+         */
+        static void removeChild(InnerNode* parent, int index);
+
+        /**
+         * @brief Reparte las llaves de una hoja llena más `key` entre ella y una hoja nueva.
+         *
+         * @return La hoja nueva, que queda a la derecha de `leaf` en la lista.
+         */
+        BPlusNode* splitLeaf(BPlusNode* leaf, int position, int key);
+
+        /**
+         * @brief Reparte un nodo interno lleno más el separador y el hijo nuevos.
+         *
+         * @param separator Recibe el separador nuevo y devuelve el que sube al padre.
+         * @return El nodo interno nuevo, a la derecha de `node`.
+         */
+        InnerNode* splitInner(InnerNode* node, int index, int& separator, BPlusNode* child);
+
+        /**
+         * @brief Repara el hijo `index` de `parent`, que quedó con menos de `MIN_KEYS` llaves.
+         *
+         * @effect Pide una llave prestada a un hermano que tenga de sobra o, si ninguno
+         *         tiene, fusiona el hijo con un hermano y quita un separador de `parent`.
+         */
+        void rebalanceChild(InnerNode* parent, int index);
+
+        /**
+         * @brief Fusiona el hijo `index + 1` de `parent` dentro del hijo `index`.
+         */
+        void mergeChildren(InnerNode* parent, int index);
+
+        /**
+         * @brief Elimina todos los nodos de un subárbol.
+         */
+        void clear(BPlusNode* node);
+
+        /**
+         * @brief Escribe el tamaño y los nodos en preorden, un nodo por línea.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+    public:
+        /**
+         * @brief Constructs an empty tree.
+         */
+        BPlusTree();
+
+        BPlusTree(const BPlusTree&) = delete;
+        BPlusTree& operator=(const BPlusTree&) = delete;
+
+        /**
+         * @brief Deletes every node of the tree.
+         */
+        ~BPlusTree();
+
+        /**
+         * @brief Inserta un elemento en su hoja, dividiendo los nodos llenos del camino.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en el árbol.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el árbol, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento y repara los nodos que queden con menos de la mitad.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Removes every key from the tree.
+         */
+        void clear();
+
+        /**
+         * @brief Devuelve la cantidad de llaves del árbol.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Llama a `visit` con cada llave de [lo, hi) en orden ascendente.
+         *
+         * @effect Baja una vez hasta la hoja de `lo` y luego sigue la lista de hojas.
+         *
+         * @require `visit` no debe insertar ni eliminar llaves del árbol.
+         *
+         * @param lo El límite inferior, incluido.
+         * @param hi El límite superior, excluido.
+         * @param visit Se llama con cada llave del intervalo.
+         */
+        template <typename Visitor>
+        void forEachInRange(int lo, int hi, Visitor visit) const {
+            const BPlusNode* leaf = findLeaf(lo);
+            if (leaf == nullptr) {
+                return;
+            }
+            for (int i = lowerBound(leaf, lo); leaf != nullptr; leaf = leaf->next, i = 0) {
+                for (; i < leaf->count; ++i) {
+                    if (leaf->keys[i] >= hi) {
+                        return;
+                    }
+                    visit(leaf->keys[i]);
+                }
+            }
+        }
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol en orden ascendente.
+         *
+         * @effect Baja hasta la hoja más a la izquierda y luego sigue la lista de hojas.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño del árbol y sus nodos en preorden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes ocupados por las hojas y los nodos internos.
+         */
+        size_t memoryUsage() override;
+};
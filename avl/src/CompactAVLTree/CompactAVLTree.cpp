@@ -0,0 +1,336 @@
+#include "CompactAVLTree.hpp"
+#include <sstream>
+#include <stdexcept>
+#include "../Serialization/BufferedWriter.hpp"
+
+static_assert(sizeof(int) == 4, "CompactAVLTree packs 4-byte keys");
+
+CompactAVLTree::CompactAVLTree()
+    : nodes(1)
+    , root(0)
+    , freeHead(0)
+    , size(0) {
+}
+
+uint32_t CompactAVLTree::allocate(int element) {
+    uint32_t index;
+
+    if (freeHead != 0) {
+        // Reciclar un nodo liberado
+        index = freeHead;
+        freeHead = nodes[index].left;
+    } else {
+        if (nodes.size() > MAX_NODES) {
+            throw std::length_error("CompactAVLTree: node pool is full");
+        }
+        index = static_cast<uint32_t>(nodes.size());
+        nodes.push_back(CompactNode());
+    }
+
+    CompactNode& node = nodes[index];
+    node.data = element;
+    node.left = 0;
+    node.right = 0;
+    node.balance = 1;
+    return index;
+}
+
+void CompactAVLTree::release(uint32_t index) {
+    // El hijo izquierdo se reutiliza como enlace de la lista libre
+    nodes[index].left = freeHead;
+    freeHead = index;
+}
+
+uint32_t CompactAVLTree::child(uint32_t index, int dir) const {
+    return dir ? nodes[index].right : nodes[index].left;
+}
+
+void CompactAVLTree::setChild(uint32_t index, int dir, uint32_t value) {
+    if (dir) {
+        nodes[index].right = value;
+    } else {
+        nodes[index].left = value;
+    }
+}
+
+int CompactAVLTree::getBalance(uint32_t index) const {
+    return static_cast<int>(nodes[index].balance) - 1;
+}
+
+void CompactAVLTree::setBalance(uint32_t index, int balance) {
+    nodes[index].balance = static_cast<uint32_t>(balance + 1);
+}
+
+uint32_t CompactAVLTree::rotate(uint32_t index, int heavy, bool& shrunk) {
+    int light = 1 - heavy;
+    int sign = heavy ? 1 : -1;
+    uint32_t top = child(index, heavy);
+    int topBalance = getBalance(top);
+
+    // Rotación simple: el hijo pesado está balanceado o se inclina hacia el mismo lado
+    if (topBalance * sign >= 0) {
+        setChild(index, heavy, child(top, light));
+        setChild(top, light, index);
+        if (topBalance == 0) {
+            // Solo ocurre al eliminar: la altura del subárbol no cambia
+            setBalance(index, sign);
+            setBalance(top, -sign);
+            shrunk = false;
+        } else {
+            setBalance(index, 0);
+            setBalance(top, 0);
+            shrunk = true;
+        }
+        return top;
+    }
+
+    // Rotación doble: el nieto sube a la raíz del subárbol
+    uint32_t grandchild = child(top, light);
+    int grandchildBalance = getBalance(grandchild);
+    setChild(index, heavy, child(grandchild, light));
+    setChild(top, light, child(grandchild, heavy));
+    setChild(grandchild, light, index);
+    setChild(grandchild, heavy, top);
+
+    setBalance(index, grandchildBalance == sign ? -sign : 0);
+    setBalance(top, grandchildBalance == -sign ? sign : 0);
+    setBalance(grandchild, 0);
+    shrunk = true;
+    return grandchild;
+}
+
+void CompactAVLTree::relink(const uint32_t* path, const int* dirs, int depth,
+        uint32_t subtree) {
+    if (depth == 0) {
+        root = subtree;
+    } else {
+        setChild(path[depth - 1], dirs[depth - 1], subtree);
+    }
+}
+
+void CompactAVLTree::insert(int element) {
+    uint32_t path[MAX_DEPTH];
+    int dirs[MAX_DEPTH];
+    int depth = 0;
+
+    // Buscar la posición guardando el camino desde la raíz
+    uint32_t current = root;
+    while (current != 0) {
+        int data = nodes[current].data;
+        if (element == data) {
+            return; // element already exists in the tree
+        }
+        int dir = element > data;
+        path[depth] = current;
+        dirs[depth] = dir;
+        ++depth;
+        current = child(current, dir);
+    }
+
+    uint32_t leaf = allocate(element);
+    relink(path, dirs, depth, leaf);
+    size++;
+
+    // Subir por el camino actualizando los factores de balance
+    for (int i = depth - 1; i >= 0; --i) {
+        int balance = getBalance(path[i]) + (dirs[i] ? 1 : -1);
+        if (balance == 0) {
+            setBalance(path[i], 0);
+            break; // la altura del subárbol no cambió
+        }
+        if (balance == 1 || balance == -1) {
+            setBalance(path[i], balance);
+            continue; // el subárbol creció un nivel
+        }
+
+        // Tras rotar, el subárbol recupera la altura que tenía antes de insertar
+        bool shrunk;
+        relink(path, dirs, i, rotate(path[i], dirs[i], shrunk));
+        break;
+    }
+}
+
+bool CompactAVLTree::contains(int element) {
+    const CompactNode* pool = nodes.data();
+    uint32_t current = root;
+
+    while (current != 0) {
+        const CompactNode& node = pool[current];
+        if (element < node.data) {
+            current = node.left;
+        } else if (element > node.data) {
+            current = node.right;
+        } else {
+            return true; // element found
+        }
+    }
+
+    return false; // element not found
+}
+
+void CompactAVLTree::erase(int element) {
+    uint32_t path[MAX_DEPTH];
+    int dirs[MAX_DEPTH];
+    int depth = 0;
+
+    // Encontrar el nodo a eliminar guardando el camino
+    uint32_t current = root;
+    while (current != 0 && nodes[current].data != element) {
+        int dir = element > nodes[current].data;
+        path[depth] = current;
+        dirs[depth] = dir;
+        ++depth;
+        current = child(current, dir);
+    }
+
+    // Si no se encuentra el elemento, salir
+    if (current == 0) {
+        return;
+    }
+
+    // Con dos hijos, copiar el sucesor en orden y eliminar el sucesor
+    if (nodes[current].left != 0 && nodes[current].right != 0) {
+        path[depth] = current;
+        dirs[depth] = 1;
+        ++depth;
+        uint32_t successor = nodes[current].right;
+        while (nodes[successor].left != 0) {
+            path[depth] = successor;
+            dirs[depth] = 0;
+            ++depth;
+            successor = nodes[successor].left;
+        }
+        nodes[current].data = nodes[successor].data;
+        current = successor;
+    }
+
+    // El nodo tiene a lo sumo un hijo, que ocupa su lugar
+    uint32_t replacement = nodes[current].left != 0 ? nodes[current].left
+        : static_cast<uint32_t>(nodes[current].right);
+    relink(path, dirs, depth, replacement);
+    release(current);
+    size--;
+
+    if (size == 0) {
+        // Reiniciar el pool para que el próximo llenado vuelva a ser contiguo
+        this->clear();
+        return;
+    }
+
+    // Subir por el camino: el lado dirs[i] perdió un nivel
+    for (int i = depth - 1; i >= 0; --i) {
+        int balance = getBalance(path[i]) - (dirs[i] ? 1 : -1);
+        if (balance == 1 || balance == -1) {
+            setBalance(path[i], balance);
+            break; // la altura del subárbol no cambió
+        }
+        if (balance == 0) {
+            setBalance(path[i], 0);
+            continue; // el subárbol perdió un nivel
+        }
+
+        bool shrunk;
+        relink(path, dirs, i, rotate(path[i], balance > 0 ? 1 : 0, shrunk));
+        if (!shrunk) {
+            break;
+        }
+    }
+}
+
+void CompactAVLTree::clear() {
+    nodes.resize(1);
+    root = 0;
+    freeHead = 0;
+    size = 0;
+}
+
+bool CompactAVLTree::forEachElement(const std::function<void(int)>& visit) {
+    uint32_t pending[MAX_DEPTH + 1];
+    int depth = 0;
+    if (root != 0) {
+        pending[depth++] = root;
+    }
+    while (depth > 0) {
+        const CompactNode& node = nodes[pending[--depth]];
+        visit(node.data);
+        if (node.right != 0) {
+            pending[depth++] = node.right;
+        }
+        if (node.left != 0) {
+            pending[depth++] = node.left;
+        }
+    }
+    return true;
+}
+
+std::string CompactAVLTree::toString() {
+    std::ostringstream stream;
+    writeTo(stream);
+    return stream.str();
+}
+
+bool CompactAVLTree::writeTo(std::ostream& stream) {
+    BufferedWriter writer(stream);
+    writeTo(writer);
+    return writer.flush();
+}
+
+bool CompactAVLTree::writeTo(FILE* file) {
+    BufferedWriter writer(file);
+    writeTo(writer);
+    return writer.flush();
+}
+
+void CompactAVLTree::writeTo(BufferedWriter& writer) const {
+    writer.write("Size: ");
+    writer.write(static_cast<int>(size));
+    writer.write("\nElements:\n");
+
+    // En preorden la pila guarda a lo sumo un hermano derecho por nivel
+    uint32_t pending[MAX_DEPTH + 1];
+    int depth = 0;
+    if (root != 0) {
+        pending[depth++] = root;
+    }
+    while (depth > 0) {
+        uint32_t index = pending[--depth];
+        const CompactNode& node = nodes[index];
+
+        writer.write("Node: ");
+        writer.write(node.data);
+        writer.write("-->");
+        // Mostrar hijos
+        if (node.left != 0 || node.right != 0) {
+            writer.write("  Children: ");
+            if (node.left != 0) {
+                writer.write("Left: ");
+                writer.write(nodes[node.left].data);
+            } else {
+                writer.write("Left: None");
+            }
+            writer.write(", ");
+            if (node.right != 0) {
+                writer.write("Right: ");
+                writer.write(nodes[node.right].data);
+            } else {
+                writer.write("Right: None");
+            }
+        } else {
+            writer.write("  No children");
+        }
+        writer.write(" Balance: ");
+        writer.write(getBalance(index));
+        writer.write("\n");
+
+        if (node.right != 0) {
+            pending[depth++] = node.right;
+        }
+        if (node.left != 0) {
+            pending[depth++] = node.left;
+        }
+    }
+}
+
+size_t CompactAVLTree::memoryUsage() {
+    return nodes.size() * sizeof(CompactNode);
+}
@@ -0,0 +1,187 @@
+#pragma once
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
+#include <string>
+#include <vector>
+#include "../Dict/Dict.h"
+
+class BufferedWriter;
+
+/**
+ * @class CompactAVLTree
+ * @brief An AVL tree whose nodes live in one contiguous pool and are linked by 32-bit indices.
+ *
+ * Each node takes 12 bytes: the key, the index of the left child, and the index of the
+ * right child packed with a 2-bit balance factor. There is no parent link; insertions
+ * and deletions remember the path from the root in a small fixed-size stack and retrace
+ * it to restore the AVL property. Index 0 is reserved as the null child, and erased
+ * nodes are recycled through a free list linked by their left index.
+ */
+class CompactAVLTree : public Dict {
+    protected:
+        /**
+         * @struct CompactNode
+         * @brief A pool entry of the compact AVL tree.
+         *
+         * @var CompactNode::data
+         * The key stored in the node.
+         *
+         * @var CompactNode::left
+         * Pool index of the left child, 0 if there is none.
+         *
+         * @var CompactNode::right
+         * Pool index of the right child, 0 if there is none.
+         *
+         * @var CompactNode::balance
+         * height(right) - height(left) + 1, so it always fits in two bits.
+         */
+        struct CompactNode {
+            int data;
+            uint32_t left;
+            uint32_t right : 30;
+            uint32_t balance : 2;
+        };
+        static_assert(sizeof(CompactNode) == 12, "CompactNode must stay 12 bytes");
+
+        /// The largest pool index that fits in the packed right child field.
+        static const uint32_t MAX_NODES = (1u << 30) - 1;
+        /// Enough room for the path of any tree that fits in the pool.
+        static const int MAX_DEPTH = 64;
+
+        std::vector<CompactNode> nodes; /// Node pool; nodes[0] is the null sentinel.
+        uint32_t root;     /// Pool index of the root, 0 when the tree is empty.
+        uint32_t freeHead; /// First recycled node, 0 when the free list is empty.
+        int size;          /// The number of keys in the tree.
+
+        /**
+         * @brief Takes a node from the free list or from the end of the pool.
+         *
+         * @effect May grow the pool, which invalidates references into `nodes`.
+         *
+         * @param element The key stored in the new node.
+         * @return The pool index of the new leaf.
+         */
+        uint32_t allocate(int element);
+
+        /**
+         * @brief Pushes a node that is no longer linked onto the free list.
+         */
+        void release(uint32_t index);
+
+        /**
+         * @brief Returns the child of `index` on side `dir` (0 = left, 1 = right).
+         */
+        uint32_t child(uint32_t index, int dir) const;
+
+        /**
+         * @brief Makes `value` the child of `index` on side `dir` (0 = left, 1 = right).
+         */
+        void setChild(uint32_t index, int dir, uint32_t value);
+
+        /**
+         * @brief Returns the balance factor height(right) - height(left) of a node.
+         */
+        int getBalance(uint32_t index) const;
+
+        /**
+         * @brief Stores the balance factor (-1, 0 or 1) of a node.
+         */
+        void setBalance(uint32_t index, int balance);
+
+        /**
+         * @brief Rotates a subtree whose balance factor reached 2 or -2.
+         *
+         * @effect Applies the single or double rotation towards the lighter side and fixes
+         *         the balance factors of the nodes involved.
+         *
+         * @param index The root of the unbalanced subtree.
+         * @param heavy The heavy side: 1 when the balance factor is 2, 0 when it is -2.
+         * @param shrunk Set to true when the rotated subtree ends up one level shorter than
+         *        it was before the rotation.
+         * @return The pool index of the new subtree root.
+         */
+        uint32_t rotate(uint32_t index, int heavy, bool& shrunk);
+
+        /**
+         * @brief Links `subtree` where `path[depth - 1]` pointed through `dirs[depth - 1]`,
+         *        or makes it the root when `depth` is 0.
+         */
+        void relink(const uint32_t* path, const int* dirs, int depth, uint32_t subtree);
+
+        /**
+         * @brief Writes the size of the tree and its nodes in preorder, using a fixed-size stack.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+    public:
+        /**
+         * @brief Constructs an empty tree whose pool only holds the null sentinel.
+         */
+        CompactAVLTree();
+
+        /**
+         * @brief Inserta un elemento en el árbol, recorriendo el camino guardado para rebalancear.
+         *
+         * @modifies Puede agregar un nodo al pool y rotar los nodos del camino.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente en el árbol.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el árbol, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento del árbol y lo rebalancea si es necesario.
+         *
+         * @effect Si el nodo tiene dos hijos, se reemplaza su valor por el del sucesor en orden
+         *         y se elimina el sucesor. Cuando el árbol queda vacío, el pool se reinicia.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Removes every element and shrinks the pool back to the null sentinel.
+         */
+        void clear();
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol, en preorden con una pila fija.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve una representación en forma de cadena del árbol.
+         *
+         * @return Una cadena con el tamaño del árbol y sus nodos en preorden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Escribe en `stream` lo mismo que devuelve `toString`, sin armar la cadena.
+         *
+         * @return false si el flujo reportó un error.
+         */
+        bool writeTo(std::ostream& stream);
+
+        /**
+         * @brief Escribe en `file` lo mismo que devuelve `toString`, sin armar la cadena.
+         *
+         * @return false si alguna escritura falló.
+         */
+        bool writeTo(FILE* file);
+
+        /**
+         * @brief Devuelve los bytes ocupados por las entradas del pool, incluidas las libres.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,144 @@
+#include "EpochReclaimer.hpp"
+
+/**
+ * @struct EpochThreadSlot
+ * @brief Holds the record of a thread and gives it back when the thread exits.
+ */
+struct EpochThreadSlot {
+    EpochReclaimer::Record* record = nullptr;
+
+    ~EpochThreadSlot() {
+        if (record != nullptr) {
+            EpochReclaimer::instance().releaseRecord(record);
+        }
+    }
+};
+
+static thread_local EpochThreadSlot threadSlot;
+
+EpochReclaimer& EpochReclaimer::instance() {
+    static EpochReclaimer reclaimer;
+    return reclaimer;
+}
+
+EpochReclaimer::EpochReclaimer()
+    : globalEpoch(1)
+    , records(nullptr) {
+}
+
+EpochReclaimer::~EpochReclaimer() {
+    // Al terminar el proceso ya no quedan secciones críticas abiertas
+    Record* record = records.load();
+    while (record != nullptr) {
+        Record* next = record->next;
+        reclaim(record->retired, UINT64_MAX);
+        delete record;
+        record = next;
+    }
+    reclaim(orphans, UINT64_MAX);
+}
+
+EpochReclaimer::Record* EpochReclaimer::localRecord() {
+    if (threadSlot.record == nullptr) {
+        threadSlot.record = acquireRecord();
+    }
+    return threadSlot.record;
+}
+
+EpochReclaimer::Record* EpochReclaimer::acquireRecord() {
+    // Reutilizar el registro de un hilo que ya terminó
+    for (Record* record = records.load(); record != nullptr; record = record->next) {
+        bool free = false;
+        if (!record->inUse.load() && record->inUse.compare_exchange_strong(free, true)) {
+            return record;
+        }
+    }
+
+    Record* record = new Record();
+    Record* head = records.load();
+    do {
+        record->next = head;
+    } while (!records.compare_exchange_weak(head, record));
+    return record;
+}
+
+void EpochReclaimer::releaseRecord(Record* record) {
+    {
+        std::lock_guard<std::mutex> lock(orphanMutex);
+        orphans.insert(orphans.end(), record->retired.begin(), record->retired.end());
+    }
+    record->retired.clear();
+    record->depth = 0;
+    record->sinceAdvance = 0;
+    record->epoch.store(0);
+    record->inUse.store(false);
+}
+
+void EpochReclaimer::enter() {
+    Record* record = localRecord();
+    if (record->depth++ == 0) {
+        // Anunciar la época antes de leer cualquier nodo compartido
+        record->epoch.store(globalEpoch.load());
+    }
+}
+
+void EpochReclaimer::exit() {
+    Record* record = localRecord();
+    if (--record->depth == 0) {
+        record->epoch.store(0, std::memory_order_release);
+    }
+}
+
+void EpochReclaimer::retire(void* pointer, Deleter deleter) {
+    Record* record = localRecord();
+    record->retired.push_back(Retired{pointer, deleter, globalEpoch.load()});
+
+    if (++record->sinceAdvance >= ADVANCE_INTERVAL) {
+        record->sinceAdvance = 0;
+        tryAdvance();
+        reclaim(record->retired, globalEpoch.load());
+    }
+}
+
+void EpochReclaimer::collect() {
+    tryAdvance();
+    tryAdvance();
+    reclaim(localRecord()->retired, globalEpoch.load());
+    std::lock_guard<std::mutex> lock(orphanMutex);
+    reclaim(orphans, globalEpoch.load());
+}
+
+bool EpochReclaimer::tryAdvance() {
+    uint64_t epoch = globalEpoch.load();
+
+    // Un hilo activo que todavía anuncia una época anterior bloquea el avance
+    for (Record* record = records.load(); record != nullptr; record = record->next) {
+        uint64_t announced = record->epoch.load();
+        if (announced != 0 && announced != epoch) {
+            return false;
+        }
+    }
+    if (!globalEpoch.compare_exchange_strong(epoch, epoch + 1)) {
+        return false;
+    }
+
+    // Aprovechar el avance para liberar lo que dejaron los hilos que terminaron
+    std::unique_lock<std::mutex> lock(orphanMutex, std::try_to_lock);
+    if (lock.owns_lock()) {
+        reclaim(orphans, epoch + 1);
+    }
+    return true;
+}
+
+void EpochReclaimer::reclaim(std::vector<Retired>& list, uint64_t epoch) {
+    // Los huérfanos mezclan hilos, así que se revisa toda la lista y no solo un prefijo
+    size_t kept = 0;
+    for (size_t i = 0; i < list.size(); ++i) {
+        if (epoch == UINT64_MAX || list[i].epoch + 2 <= epoch) {
+            list[i].deleter(list[i].pointer);
+        } else {
+            list[kept++] = list[i];
+        }
+    }
+    list.resize(kept);
+}
@@ -0,0 +1,162 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * @class EpochReclaimer
+ * @brief Process-wide epoch-based reclamation for lock-free and optimistic structures.
+ *
+ * A thread that reads shared nodes does it inside an `EpochGuard`, which announces the
+ * global epoch it started in. A node that has been unlinked is handed to `retire`
+ * instead of being deleted; it is freed once the global epoch has advanced twice past
+ * its retirement, because by then every thread that could still hold a pointer to it
+ * has left its critical section. The epoch only advances when every active thread has
+ * announced the current one.
+ *
+ * Threads get a record on first use and give it back when they exit; nodes that an
+ * exiting thread had not freed yet are moved to a shared orphan list.
+ */
+class EpochReclaimer {
+    public:
+        /// Function that frees a retired object.
+        typedef void (*Deleter)(void*);
+
+        /**
+         * @brief Returns the reclaimer shared by every concurrent structure.
+         */
+        static EpochReclaimer& instance();
+
+        /**
+         * @brief Enters a critical section; nested calls only count the depth.
+         */
+        void enter();
+
+        /**
+         * @brief Leaves the critical section opened by the matching `enter`.
+         */
+        void exit();
+
+        /**
+         * @brief Schedules an object that is no longer reachable to be freed later.
+         *
+         * @require `pointer` must already be unlinked, so that no thread that enters a
+         *          critical section from now on can reach it.
+         *
+         * @effect Every few retirements tries to advance the epoch and frees the objects
+         *         of this thread that no critical section can still see.
+         *
+         * @param pointer The object to free.
+         * @param deleter The function that frees it.
+         */
+        void retire(void* pointer, Deleter deleter);
+
+        /**
+         * @brief Same as `retire(void*, Deleter)`, freeing the object with `delete`.
+         */
+        template <typename T>
+        void retire(T* object) {
+            retire(object, [](void* pointer) {
+                delete static_cast<T*>(pointer);
+            });
+        }
+
+        /**
+         * @brief Frees every retired object whose grace period is over.
+         *
+         * @effect Tries to advance the epoch twice, so with no other thread inside a
+         *         critical section everything retired so far is freed.
+         */
+        void collect();
+
+    private:
+        /**
+         * @struct Retired
+         * @brief An object waiting for its grace period to end.
+         */
+        struct Retired {
+            void* pointer;
+            Deleter deleter;
+            uint64_t epoch; /// Global epoch when the object was retired.
+        };
+
+        /**
+         * @struct Record
+         * @brief The state of one thread, reused by later threads after it exits.
+         */
+        struct Record {
+            Record()
+            : epoch(0)
+            , inUse(true)
+            , depth(0)
+            , sinceAdvance(0)
+            , next(nullptr) {
+            };
+            std::atomic<uint64_t> epoch; /// Announced epoch, 0 outside critical sections.
+            std::atomic<bool> inUse;     /// Whether a live thread owns the record.
+            int depth;                   /// Nesting of `enter` calls.
+            size_t sinceAdvance;         /// Retirements since the last attempt to advance.
+            std::vector<Retired> retired; /// Objects retired by the owner thread.
+            Record* next;                /// Next record of the list.
+        };
+
+        friend struct EpochThreadSlot;
+
+        std::atomic<uint64_t> globalEpoch; /// Starts at 1 so that 0 can mean "inactive".
+        std::atomic<Record*> records;      /// Every record ever created, never shrinking.
+        std::mutex orphanMutex;            /// Protects `orphans`.
+        std::vector<Retired> orphans;      /// Objects left behind by threads that exited.
+
+        /// Retirements between two attempts to advance the epoch.
+        static const size_t ADVANCE_INTERVAL = 64;
+
+        EpochReclaimer();
+        ~EpochReclaimer();
+
+        /**
+         * @brief Returns the record of the calling thread, taking one on first use.
+         */
+        Record* localRecord();
+
+        /**
+         * @brief Reuses a record released by an exited thread, or creates a new one.
+         */
+        Record* acquireRecord();
+
+        /**
+         * @brief Moves the pending objects of an exiting thread to the orphans and frees its record.
+         */
+        void releaseRecord(Record* record);
+
+        /**
+         * @brief Advances the global epoch if every active thread has announced it.
+         *
+         * @return true if the epoch advanced.
+         */
+        bool tryAdvance();
+
+        /**
+         * @brief Frees the objects of `list` retired at least two epochs before `epoch`.
+         */
+        static void reclaim(std::vector<Retired>& list, uint64_t epoch);
+};
+
+/**
+ * @class EpochGuard
+ * @brief Keeps the calling thread inside an epoch critical section while it lives.
+ */
+class EpochGuard {
+    public:
+        EpochGuard() {
+            EpochReclaimer::instance().enter();
+        };
+
+        ~EpochGuard() {
+            EpochReclaimer::instance().exit();
+        };
+
+        EpochGuard(const EpochGuard&) = delete;
+        EpochGuard& operator=(const EpochGuard&) = delete;
+};
@@ -0,0 +1,51 @@
+#pragma once
+#include <atomic>
+#include <thread>
+
+/**
+ * @class SpinLock
+ * @brief A one-byte test-and-test-and-set lock for critical sections of a few stores.
+ *
+ * It satisfies BasicLockable, so it works with `std::lock_guard`. After a short spin
+ * the waiting thread yields, so a holder that was preempted can still make progress
+ * when there are more threads than cores.
+ */
+class SpinLock {
+    private:
+        std::atomic<bool> locked; /// true while some thread holds the lock.
+
+        /// Failed checks before the waiting thread starts yielding.
+        static const int SPINS_BEFORE_YIELD = 64;
+
+    public:
+        SpinLock()
+        : locked(false) {
+        };
+
+        SpinLock(const SpinLock&) = delete;
+        SpinLock& operator=(const SpinLock&) = delete;
+
+        /**
+         * @brief Waits until the lock is free and takes it.
+         */
+        void lock() {
+            while (locked.exchange(true, std::memory_order_acquire)) {
+                // Esperar leyendo, sin escribir la línea de caché en cada intento
+                int spins = 0;
+                while (locked.load(std::memory_order_relaxed)) {
+                    if (++spins >= SPINS_BEFORE_YIELD) {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        };
+
+        /**
+         * @brief Releases the lock.
+         *
+         * @require The calling thread must hold the lock.
+         */
+        void unlock() {
+            locked.store(false, std::memory_order_release);
+        };
+};
@@ -0,0 +1,642 @@
+#include "ConcurrentAVLTree.hpp"
+#include <algorithm>
+#include <climits>
+#include <mutex>
+#include "../Concurrency/EpochReclaimer.hpp"
+
+typedef std::lock_guard<SpinLock> NodeLock;
+
+ConcurrentAVLTree::ConcurrentAVLTree()
+    : rootHolder(INT_MIN, 0, false, nullptr) {
+}
+
+ConcurrentAVLTree::~ConcurrentAVLTree() {
+    clear(rootHolder.right.load());
+}
+
+bool ConcurrentAVLTree::isUnlinked(uint64_t version) {
+    return version == UNLINKED;
+}
+
+bool ConcurrentAVLTree::isChanging(uint64_t version) {
+    return (version & (GROWING | SHRINKING)) != 0;
+}
+
+bool ConcurrentAVLTree::isShrinkingOrUnlinked(uint64_t version) {
+    return (version & (SHRINKING | UNLINKED)) != 0;
+}
+
+bool ConcurrentAVLTree::hasShrunkOrUnlinked(uint64_t original, uint64_t current) {
+    return ((original ^ current) & ~(GROWING | GROW_COUNT_MASK)) != 0;
+}
+
+int ConcurrentAVLTree::height(ConcurrentNode* node) {
+    return (node == nullptr) ? 0 : node->height.load();
+}
+
+int ConcurrentAVLTree::compare(int key, const ConcurrentNode* node) {
+    return (key < node->key) ? -1 : (key > node->key) ? 1 : 0;
+}
+
+void ConcurrentAVLTree::waitUntilNotChanging(ConcurrentNode* node) {
+    uint64_t version = node->version.load();
+    if (!isChanging(version)) {
+        return;
+    }
+    for (int i = 0; i < SPINS_BEFORE_LOCK; ++i) {
+        if (node->version.load() != version) {
+            return;
+        }
+    }
+    // La rotación tiene el candado del nodo hasta terminar
+    node->lock.lock();
+    node->lock.unlock();
+}
+
+bool ConcurrentAVLTree::contains(int element) {
+    EpochGuard guard;
+
+    while (true) {
+        ConcurrentNode* right = rootHolder.right.load();
+        if (right == nullptr) {
+            return false;
+        }
+        int dir = compare(element, right);
+        if (dir == 0) {
+            return right->present.load();
+        }
+        uint64_t version = right->version.load();
+        if (isShrinkingOrUnlinked(version)) {
+            waitUntilNotChanging(right);
+        } else if (right == rootHolder.right.load()) {
+            Attempt result = attemptGet(element, right, dir, version);
+            if (result != RETRY) {
+                return result == FOUND;
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Attempt ConcurrentAVLTree::attemptGet(int key, ConcurrentNode* node,
+        int dir, uint64_t nodeVersion) {
+    while (true) {
+        ConcurrentNode* child = node->child(dir);
+        if (child == nullptr) {
+            // El hijo nulo solo cuenta si el nodo no se movió mientras se leía
+            if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+                return RETRY;
+            }
+            return ABSENT;
+        }
+
+        int childDir = compare(key, child);
+        if (childDir == 0) {
+            return child->present.load() ? FOUND : ABSENT;
+        }
+
+        uint64_t childVersion = child->version.load();
+        if (isShrinkingOrUnlinked(childVersion)) {
+            waitUntilNotChanging(child);
+            if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+                return RETRY;
+            }
+        } else if (child != node->child(dir)) {
+            if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+                return RETRY;
+            }
+        } else {
+            // Validar el nodo antes de confiar en el hijo leído de él
+            if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+                return RETRY;
+            }
+            Attempt result = attemptGet(key, child, childDir, childVersion);
+            if (result != RETRY) {
+                return result;
+            }
+        }
+    }
+}
+
+void ConcurrentAVLTree::insert(int element) {
+    update(element, true);
+}
+
+void ConcurrentAVLTree::erase(int element) {
+    update(element, false);
+}
+
+bool ConcurrentAVLTree::update(int key, bool inserting) {
+    EpochGuard guard;
+
+    while (true) {
+        ConcurrentNode* right = rootHolder.right.load();
+        if (right == nullptr) {
+            if (!inserting) {
+                return false;
+            }
+            if (attemptInsertIntoEmpty(key)) {
+                return true;
+            }
+            continue;
+        }
+
+        uint64_t version = right->version.load();
+        if (isShrinkingOrUnlinked(version)) {
+            waitUntilNotChanging(right);
+        } else if (right == rootHolder.right.load()) {
+            Attempt result = attemptUpdate(key, inserting, &rootHolder, right, version);
+            if (result != RETRY) {
+                return result == CHANGED;
+            }
+        }
+    }
+}
+
+bool ConcurrentAVLTree::attemptInsertIntoEmpty(int key) {
+    NodeLock lock(rootHolder.lock);
+    if (rootHolder.right.load() != nullptr) {
+        return false;
+    }
+    rootHolder.right.store(new ConcurrentNode(key, 1, true, &rootHolder));
+    rootHolder.height.store(2);
+    return true;
+}
+
+ConcurrentAVLTree::Attempt ConcurrentAVLTree::attemptUpdate(int key, bool inserting,
+        ConcurrentNode* parent, ConcurrentNode* node, uint64_t nodeVersion) {
+    int dir = compare(key, node);
+    if (dir == 0) {
+        return attemptNodeUpdate(inserting, parent, node);
+    }
+
+    while (true) {
+        ConcurrentNode* child = node->child(dir);
+        if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+            return RETRY;
+        }
+
+        if (child == nullptr) {
+            if (!inserting) {
+                return UNCHANGED;
+            }
+
+            // Colgar la hoja nueva con el candado del padre tomado
+            ConcurrentNode* damaged;
+            {
+                NodeLock lock(node->lock);
+                if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+                    return RETRY;
+                }
+                if (node->child(dir) != nullptr) {
+                    continue; // otro hilo colgó un hijo primero
+                }
+                node->setChild(dir, new ConcurrentNode(key, 1, true, node));
+                damaged = fixHeightLocked(node);
+            }
+            fixHeightAndRebalance(damaged);
+            return CHANGED;
+        }
+
+        uint64_t childVersion = child->version.load();
+        if (isShrinkingOrUnlinked(childVersion)) {
+            waitUntilNotChanging(child);
+        } else if (child == node->child(dir)) {
+            if (hasShrunkOrUnlinked(nodeVersion, node->version.load())) {
+                return RETRY;
+            }
+            Attempt result = attemptUpdate(key, inserting, node, child, childVersion);
+            if (result != RETRY) {
+                return result;
+            }
+        }
+    }
+}
+
+ConcurrentAVLTree::Attempt ConcurrentAVLTree::attemptNodeUpdate(bool inserting,
+        ConcurrentNode* parent, ConcurrentNode* node) {
+    if (inserting) {
+        NodeLock lock(node->lock);
+        if (isUnlinked(node->version.load())) {
+            return RETRY;
+        }
+        if (node->present.load()) {
+            return UNCHANGED; // element already exists in the tree
+        }
+        node->present.store(true);
+        return CHANGED;
+    }
+
+    if (!node->present.load()) {
+        return UNCHANGED;
+    }
+
+    if (node->left.load() == nullptr || node->right.load() == nullptr) {
+        // Con a lo sumo un hijo, el nodo se desenlaza bajo el candado del padre
+        ConcurrentNode* damaged;
+        {
+            NodeLock parentLock(parent->lock);
+            if (isUnlinked(parent->version.load()) || node->parent.load() != parent) {
+                return RETRY;
+            }
+            {
+                NodeLock lock(node->lock);
+                if (!node->present.load()) {
+                    return UNCHANGED;
+                }
+                if (!attemptUnlinkLocked(parent, node)) {
+                    return RETRY;
+                }
+            }
+            damaged = fixHeightLocked(parent);
+        }
+        EpochReclaimer::instance().retire(node);
+        fixHeightAndRebalance(damaged);
+        return CHANGED;
+    }
+
+    // Con dos hijos, el nodo se queda como nodo de ruta
+    NodeLock lock(node->lock);
+    if (isUnlinked(node->version.load())) {
+        return RETRY;
+    }
+    if (!node->present.load()) {
+        return UNCHANGED;
+    }
+    if (node->left.load() == nullptr || node->right.load() == nullptr) {
+        return RETRY; // ahora se puede desenlazar
+    }
+    node->present.store(false);
+    return CHANGED;
+}
+
+bool ConcurrentAVLTree::attemptUnlinkLocked(ConcurrentNode* parent, ConcurrentNode* node) {
+    ConcurrentNode* parentLeft = parent->left.load();
+    ConcurrentNode* parentRight = parent->right.load();
+    if (parentLeft != node && parentRight != node) {
+        return false;
+    }
+
+    ConcurrentNode* left = node->left.load();
+    ConcurrentNode* right = node->right.load();
+    if (left != nullptr && right != nullptr) {
+        return false;
+    }
+
+    ConcurrentNode* splice = (left != nullptr) ? left : right;
+    if (parentLeft == node) {
+        parent->left.store(splice);
+    } else {
+        parent->right.store(splice);
+    }
+    if (splice != nullptr) {
+        splice->parent.store(parent);
+    }
+
+    node->version.store(UNLINKED);
+    node->present.store(false);
+    return true;
+}
+
+int ConcurrentAVLTree::nodeCondition(ConcurrentNode* node) {
+    ConcurrentNode* left = node->left.load();
+    ConcurrentNode* right = node->right.load();
+
+    // Un nodo de ruta con a lo sumo un hijo sobra
+    if ((left == nullptr || right == nullptr) && !node->present.load()) {
+        return UNLINK_REQUIRED;
+    }
+
+    int nodeHeight = node->height.load();
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+    int newHeight = 1 + std::max(leftHeight, rightHeight);
+    int balanceFactor = leftHeight - rightHeight;
+
+    if (balanceFactor < -1 || balanceFactor > 1) {
+        return REBALANCE_REQUIRED;
+    }
+    return nodeHeight != newHeight ? newHeight : NOTHING_REQUIRED;
+}
+
+ConcurrentAVLTree::ConcurrentNode* ConcurrentAVLTree::fixHeightLocked(ConcurrentNode* node) {
+    int condition = nodeCondition(node);
+    switch (condition) {
+        case REBALANCE_REQUIRED:
+        case UNLINK_REQUIRED:
+            return node;
+        case NOTHING_REQUIRED:
+            return nullptr;
+        default:
+            node->height.store(condition);
+            return node->parent.load();
+    }
+}
+
+void ConcurrentAVLTree::fixHeightAndRebalance(ConcurrentNode* node) {
+    // Después de una rotación que dejó trabajo debajo, se revisan todos los ancestros
+    bool climb = false;
+
+    // Subir hasta que no quede trabajo o se llegue a rootHolder, que no tiene padre
+    while (node != nullptr && node->parent.load() != nullptr) {
+        int condition = nodeCondition(node);
+        if (isUnlinked(node->version.load())) {
+            return;
+        }
+        if (condition == NOTHING_REQUIRED) {
+            if (!climb) {
+                return;
+            }
+            node = node->parent.load();
+            continue;
+        }
+
+        if (condition != UNLINK_REQUIRED && condition != REBALANCE_REQUIRED) {
+            NodeLock lock(node->lock);
+            ConcurrentNode* next = fixHeightLocked(node);
+            node = (next == nullptr && climb) ? node->parent.load() : next;
+        } else {
+            ConcurrentNode* parent = node->parent.load();
+            NodeLock parentLock(parent->lock);
+            if (!isUnlinked(parent->version.load()) && node->parent.load() == parent) {
+                NodeLock lock(node->lock);
+                ConcurrentNode* next = rebalanceLocked(parent, node, climb);
+                node = (next == nullptr && climb) ? parent : next;
+            }
+            // si el padre cambió, se vuelve a revisar el mismo nodo
+        }
+    }
+}
+
+ConcurrentAVLTree::ConcurrentNode* ConcurrentAVLTree::rebalanceLocked(ConcurrentNode* parent,
+        ConcurrentNode* node, bool& climb) {
+    ConcurrentNode* left = node->left.load();
+    ConcurrentNode* right = node->right.load();
+
+    if ((left == nullptr || right == nullptr) && !node->present.load()) {
+        if (attemptUnlinkLocked(parent, node)) {
+            EpochReclaimer::instance().retire(node);
+            return fixHeightLocked(parent);
+        }
+        return node;
+    }
+
+    int nodeHeight = node->height.load();
+    int leftHeight = height(left);
+    int rightHeight = height(right);
+    int newHeight = 1 + std::max(leftHeight, rightHeight);
+    int balanceFactor = leftHeight - rightHeight;
+
+    if (balanceFactor > 1) {
+        return rebalanceTowards(parent, node, left, rightHeight, -1, climb);
+    } else if (balanceFactor < -1) {
+        return rebalanceTowards(parent, node, right, leftHeight, 1, climb);
+    } else if (newHeight != nodeHeight) {
+        node->height.store(newHeight);
+        return fixHeightLocked(parent);
+    }
+    return nullptr;
+}
+
+ConcurrentAVLTree::ConcurrentNode* ConcurrentAVLTree::rebalanceTowards(ConcurrentNode* parent,
+        ConcurrentNode* node, ConcurrentNode* heavyChild, int lightHeight, int heavy, bool& climb) {
+    int light = -heavy;
+    NodeLock heavyLock(heavyChild->lock);
+
+    if (heavyChild->height.load() - lightHeight <= 1) {
+        return node; // otro hilo ya lo corrigió; revisar de nuevo
+    }
+
+    ConcurrentNode* inner = heavyChild->child(light);
+    int outerHeight = height(heavyChild->child(heavy));
+    int innerHeight0 = height(inner);
+
+    // Caso Left Left o Right Right: rotación simple
+    if (outerHeight >= innerHeight0) {
+        return rotateSingle(parent, node, heavyChild, lightHeight, outerHeight, inner,
+            innerHeight0, heavy, climb);
+    }
+
+    {
+        NodeLock innerLock(inner->lock);
+        int innerHeight = inner->height.load();
+        if (outerHeight >= innerHeight) {
+            return rotateSingle(parent, node, heavyChild, lightHeight, outerHeight, inner,
+                innerHeight, heavy, climb);
+        }
+
+        // Caso Left Right o Right Left: rotación doble si deja balanceado a heavyChild
+        int innerOuterHeight = height(inner->child(heavy));
+        int balanceFactor = outerHeight - innerOuterHeight;
+        if (balanceFactor >= -1 && balanceFactor <= 1) {
+            return rotateDouble(parent, node, heavyChild, lightHeight, outerHeight, inner,
+                innerOuterHeight, heavy, climb);
+        }
+    }
+
+    // El nieto interior está desbalanceado: rebalancear primero heavyChild
+    return rebalanceTowards(node, heavyChild, inner, outerHeight, light, climb);
+}
+
+ConcurrentAVLTree::ConcurrentNode* ConcurrentAVLTree::rotateSingle(ConcurrentNode* parent,
+        ConcurrentNode* node, ConcurrentNode* heavyChild, int lightHeight, int outerHeight,
+        ConcurrentNode* inner, int innerHeight, int heavy, bool& climb) {
+    int light = -heavy;
+    uint64_t nodeVersion = node->version.load();
+    uint64_t heavyVersion = heavyChild->version.load();
+    ConcurrentNode* parentLeft = parent->left.load();
+
+    node->version.store(nodeVersion | SHRINKING);
+    heavyChild->version.store(heavyVersion | GROWING);
+
+    // Realizar rotación
+    node->setChild(heavy, inner);
+    heavyChild->setChild(light, node);
+    if (parentLeft == node) {
+        parent->left.store(heavyChild);
+    } else {
+        parent->right.store(heavyChild);
+    }
+
+    heavyChild->parent.store(parent);
+    node->parent.store(heavyChild);
+    if (inner != nullptr) {
+        inner->parent.store(node);
+    }
+
+    // Actualizar alturas
+    int nodeHeight = 1 + std::max(innerHeight, lightHeight);
+    node->height.store(nodeHeight);
+    heavyChild->height.store(1 + std::max(outerHeight, nodeHeight));
+
+    heavyChild->version.store(heavyVersion + (1ull << GROW_COUNT_SHIFT));
+    node->version.store(nodeVersion + (1ull << SHRINK_COUNT_SHIFT));
+
+    // Si queda trabajo debajo, devolver ese nodo y pedir que luego se suba hasta la raíz,
+    // porque la altura de este subárbol pudo cambiar sin que parent se haya corregido
+    int nodeBalance = innerHeight - lightHeight;
+    if (nodeBalance < -1 || nodeBalance > 1) {
+        climb = true;
+        return node;
+    }
+    if ((inner == nullptr || lightHeight == 0) && !node->present.load()) {
+        climb = true;
+        return node;
+    }
+    int heavyBalance = outerHeight - nodeHeight;
+    if (heavyBalance < -1 || heavyBalance > 1) {
+        climb = true;
+        return heavyChild;
+    }
+    if (outerHeight == 0 && !heavyChild->present.load()) {
+        climb = true;
+        return heavyChild;
+    }
+    return fixHeightLocked(parent);
+}
+
+ConcurrentAVLTree::ConcurrentNode* ConcurrentAVLTree::rotateDouble(ConcurrentNode* parent,
+        ConcurrentNode* node, ConcurrentNode* heavyChild, int lightHeight, int outerHeight,
+        ConcurrentNode* inner, int innerOuterHeight, int heavy, bool& climb) {
+    int light = -heavy;
+    uint64_t nodeVersion = node->version.load();
+    uint64_t heavyVersion = heavyChild->version.load();
+    uint64_t innerVersion = inner->version.load();
+    ConcurrentNode* parentLeft = parent->left.load();
+    ConcurrentNode* innerOuter = inner->child(heavy);
+    ConcurrentNode* innerInner = inner->child(light);
+    int innerInnerHeight = height(innerInner);
+
+    node->version.store(nodeVersion | SHRINKING);
+    heavyChild->version.store(heavyVersion | SHRINKING);
+    inner->version.store(innerVersion | GROWING);
+
+    // Realizar rotación: inner sube con heavyChild y node como hijos
+    node->setChild(heavy, innerInner);
+    heavyChild->setChild(light, innerOuter);
+    inner->setChild(heavy, heavyChild);
+    inner->setChild(light, node);
+    if (parentLeft == node) {
+        parent->left.store(inner);
+    } else {
+        parent->right.store(inner);
+    }
+
+    inner->parent.store(parent);
+    heavyChild->parent.store(inner);
+    node->parent.store(inner);
+    if (innerInner != nullptr) {
+        innerInner->parent.store(node);
+    }
+    if (innerOuter != nullptr) {
+        innerOuter->parent.store(heavyChild);
+    }
+
+    // Actualizar alturas
+    int nodeHeight = 1 + std::max(innerInnerHeight, lightHeight);
+    node->height.store(nodeHeight);
+    int heavyHeight = 1 + std::max(outerHeight, innerOuterHeight);
+    heavyChild->height.store(heavyHeight);
+    inner->height.store(1 + std::max(heavyHeight, nodeHeight));
+
+    inner->version.store(innerVersion + (1ull << GROW_COUNT_SHIFT));
+    heavyChild->version.store(heavyVersion + (1ull << SHRINK_COUNT_SHIFT));
+    node->version.store(nodeVersion + (1ull << SHRINK_COUNT_SHIFT));
+
+    // Si heavyChild era un nodo de ruta y quedó con un solo hijo, desenlazarlo ya,
+    // mientras se tienen los candados de inner y heavyChild
+    if ((innerOuter == nullptr || outerHeight == 0) && !heavyChild->present.load()) {
+        attemptUnlinkLocked(inner, heavyChild);
+        EpochReclaimer::instance().retire(heavyChild);
+        heavyHeight = std::max(outerHeight, innerOuterHeight);
+        inner->height.store(1 + std::max(heavyHeight, nodeHeight));
+    }
+
+    int nodeBalance = innerInnerHeight - lightHeight;
+    if (nodeBalance < -1 || nodeBalance > 1) {
+        climb = true;
+        return node;
+    }
+    if ((innerInner == nullptr || lightHeight == 0) && !node->present.load()) {
+        climb = true;
+        return node;
+    }
+    int innerBalance = heavyHeight - nodeHeight;
+    if (innerBalance < -1 || innerBalance > 1) {
+        climb = true;
+        return inner;
+    }
+    return fixHeightLocked(parent);
+}
+
+void ConcurrentAVLTree::clear() {
+    clear(rootHolder.right.load());
+    rootHolder.right.store(nullptr);
+    rootHolder.height.store(1);
+}
+
+void ConcurrentAVLTree::clear(ConcurrentNode* node) {
+    if (node == nullptr) {
+        return;
+    }
+    clear(node->left.load());
+    clear(node->right.load());
+    delete node;
+}
+
+size_t ConcurrentAVLTree::countNodes(ConcurrentNode* node) {
+    if (node == nullptr) {
+        return 0;
+    }
+    return countNodes(node->left.load()) + 1 + countNodes(node->right.load());
+}
+
+size_t ConcurrentAVLTree::memoryUsage() {
+    return countNodes(rootHolder.right.load()) * sizeof(ConcurrentNode);
+}
+
+bool ConcurrentAVLTree::forEachElement(const std::function<void(int)>& visit) {
+    visitPresent(rootHolder.right.load(), visit);
+    return true;
+}
+
+void ConcurrentAVLTree::visitPresent(ConcurrentNode* node,
+        const std::function<void(int)>& visit) {
+    if (node == nullptr) {
+        return;
+    }
+    visitPresent(node->left.load(), visit);
+    // Los nodos de ruta no guardan una llave del diccionario
+    if (node->present.load()) {
+        visit(node->key);
+    }
+    visitPresent(node->right.load(), visit);
+}
+
+std::string ConcurrentAVLTree::toString() {
+    std::string elements;
+    size_t size = toString(rootHolder.right.load(), elements);
+
+    std::string result;
+    result += "Size: " + std::to_string(size) + "\n";
+    result += "Elements:\n";
+    result += elements;
+    return result;
+}
+
+size_t ConcurrentAVLTree::toString(ConcurrentNode* node, std::string& result) {
+    if (node == nullptr) {
+        return 0;
+    }
+
+    // Los nodos de ruta no guardan una llave del diccionario
+    size_t present = 0;
+    if (node->present.load()) {
+        result += "Node: " + std::to_string(node->key) + "-->";
+        result += " Height: " + std::to_string(node->height.load());
+        result += "\n";
+        present = 1;
+    }
+    present += toString(node->left.load(), result);
+    present += toString(node->right.load(), result);
+    return present;
+}
@@ -0,0 +1,321 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "../Concurrency/SpinLock.hpp"
+#include "../Dict/Dict.h"
+
+/**
+ * @class ConcurrentAVLTree
+ * @brief A relaxed-balance AVL tree that many threads can read and modify at once.
+ *
+ * It follows the optimistic design of Bronson et al.: every node carries a version
+ * number that rotations bump while they move the node. Readers take no locks; they
+ * descend hand over hand, recording the version of each node and checking that it has
+ * not shrunk before trusting the child they read from it, and retry from the parent when
+ * it has. Writers lock only the node they change and, to rebalance, the parent, the node
+ * and the one or two children that a rotation moves.
+ *
+ * Erasing a key with two children only clears its `present` flag and leaves the node as
+ * a router; routers are unlinked once they have at most one child. Unlinked nodes are
+ * retired through the `EpochReclaimer`, so a reader that still holds one never touches
+ * freed memory. Heights follow the usual Bronson convention (null = 0, leaf = 1) and are
+ * repaired lazily from the changed node upwards, so the tree may be briefly out of
+ * balance while several writers race.
+ */
+class ConcurrentAVLTree : public Dict {
+    protected:
+        /**
+         * @struct ConcurrentNode
+         * @brief A node whose links, height and version can be read without its lock.
+         */
+        struct ConcurrentNode {
+            ConcurrentNode(int key, int height, bool present, ConcurrentNode* parent)
+            : key(key)
+            , height(height)
+            , version(0)
+            , present(present)
+            , parent(parent)
+            , left(nullptr)
+            , right(nullptr) {
+            };
+
+            /**
+             * @brief Returns the child on the side of `dir` (negative = left, positive = right).
+             */
+            ConcurrentNode* child(int dir) const {
+                return dir < 0 ? left.load() : right.load();
+            };
+
+            /**
+             * @brief Replaces the child on the side of `dir`.
+             */
+            void setChild(int dir, ConcurrentNode* node) {
+                if (dir < 0) {
+                    left.store(node);
+                } else {
+                    right.store(node);
+                }
+            };
+
+            const int key;                       /// The key, fixed for the life of the node.
+            std::atomic<int> height;             /// Height of the subtree, 1 for a leaf.
+            std::atomic<uint64_t> version;       /// Shrink/grow counters, or UNLINKED.
+            std::atomic<bool> present;           /// false for routing and unlinked nodes.
+            std::atomic<ConcurrentNode*> parent; /// Parent node, the holder for the root.
+            std::atomic<ConcurrentNode*> left;   /// Left child.
+            std::atomic<ConcurrentNode*> right;  /// Right child.
+            SpinLock lock;                       /// Taken to change the node's fields.
+        };
+
+        /// Result of an optimistic attempt that may have to start over from the parent.
+        enum Attempt {
+            RETRY,
+            ABSENT,
+            FOUND,
+            UNCHANGED,
+            CHANGED
+        };
+
+        /// Values returned by `nodeCondition` that are not a new height.
+        enum Condition {
+            NOTHING_REQUIRED = -1,
+            UNLINK_REQUIRED = -2,
+            REBALANCE_REQUIRED = -3
+        };
+
+        /// Version bits: unlinked marker, grow and shrink flags, then the two counters.
+        static const uint64_t UNLINKED = 1;
+        static const uint64_t GROWING = 2;
+        static const uint64_t SHRINKING = 4;
+        static const int GROW_COUNT_SHIFT = 3;
+        static const uint64_t GROW_COUNT_MASK = 0xffull << GROW_COUNT_SHIFT;
+        static const int SHRINK_COUNT_SHIFT = GROW_COUNT_SHIFT + 8;
+        /// Version checks before a reader waiting on a rotation takes the node lock.
+        static const int SPINS_BEFORE_LOCK = 100;
+
+        /// Sentinel whose right child is the root; it is never rotated or unlinked.
+        ConcurrentNode rootHolder;
+
+        static bool isUnlinked(uint64_t version);
+        static bool isChanging(uint64_t version);
+        static bool isShrinkingOrUnlinked(uint64_t version);
+
+        /**
+         * @brief Indica si un nodo se movió hacia abajo o se desenlazó desde que se leyó `original`.
+         *
+         * @effect Crecer no invalida la búsqueda: las llaves que estaban debajo del nodo siguen ahí.
+         */
+        static bool hasShrunkOrUnlinked(uint64_t original, uint64_t current);
+
+        static int height(ConcurrentNode* node);
+
+        /**
+         * @brief Compara `key` con la llave de un nodo: -1 si es menor, 1 si es mayor, 0 si son iguales.
+         */
+        static int compare(int key, const ConcurrentNode* node);
+
+        /**
+         * @brief Espera a que termine la rotación que está moviendo al nodo.
+         *
+         * @effect Revisa la versión unas cuantas veces y luego toma y suelta el candado del
+         *         nodo, que la rotación mantiene tomado mientras dura.
+         */
+        static void waitUntilNotChanging(ConcurrentNode* node);
+
+        /**
+         * @brief Continúa una búsqueda desde `node`, cuya versión era `nodeVersion` al llegar.
+         *
+         * @return FOUND o ABSENT, o RETRY si `node` se movió y hay que repetir desde su padre.
+         */
+        Attempt attemptGet(int key, ConcurrentNode* node, int dir, uint64_t nodeVersion);
+
+        /**
+         * @brief Inserta o elimina `key` repitiendo el intento optimista hasta que tenga éxito.
+         *
+         * @return true si el árbol cambió.
+         */
+        bool update(int key, bool inserting);
+
+        /**
+         * @brief Cuelga la primera llave del árbol vacío bajo `rootHolder`.
+         *
+         * @return false si otro hilo llenó el árbol primero y hay que reintentar.
+         */
+        bool attemptInsertIntoEmpty(int key);
+
+        /**
+         * @brief Continúa una actualización desde `node`, hijo de `parent`.
+         *
+         * @return CHANGED, UNCHANGED o RETRY.
+         */
+        Attempt attemptUpdate(int key, bool inserting, ConcurrentNode* parent,
+            ConcurrentNode* node, uint64_t nodeVersion);
+
+        /**
+         * @brief Inserta o elimina la llave del nodo que ya la contiene.
+         *
+         * @effect Al insertar solo marca el nodo como presente. Al eliminar, desenlaza el
+         *         nodo si tiene a lo sumo un hijo; si tiene dos, lo deja como nodo de ruta.
+         */
+        Attempt attemptNodeUpdate(bool inserting, ConcurrentNode* parent, ConcurrentNode* node);
+
+        /**
+         * @brief Quita `node` del árbol colgando su único hijo de `parent`.
+         *
+         * @require Los candados de `parent` y `node` deben estar tomados.
+         *
+         * @return false si `node` ya no es hijo de `parent` o tiene dos hijos.
+         */
+        bool attemptUnlinkLocked(ConcurrentNode* parent, ConcurrentNode* node);
+
+        /**
+         * @brief Clasifica lo que necesita un nodo: nada, ser desenlazado, una rotación, o
+         *        solo una altura nueva, que es el valor devuelto en ese caso.
+         */
+        int nodeCondition(ConcurrentNode* node);
+
+        /**
+         * @brief Corrige la altura de un nodo si solo eso le hace falta.
+         *
+         * @require El candado de `node` debe estar tomado.
+         *
+         * @return El siguiente nodo que hay que revisar, o nullptr si no queda trabajo.
+         */
+        ConcurrentNode* fixHeightLocked(ConcurrentNode* node);
+
+        /**
+         * @brief Sube desde `node` corrigiendo alturas, rotando y desenlazando nodos de ruta.
+         */
+        void fixHeightAndRebalance(ConcurrentNode* node);
+
+        /**
+         * @brief Desenlaza o rota `node` según lo que necesite.
+         *
+         * @require Los candados de `parent` y `node` deben estar tomados.
+         *
+         * @param climb Se pone en true si una rotación dejó trabajo en un nodo más abajo, en
+         *        cuyo caso luego hay que revisar todos los ancestros hasta la raíz.
+         * @return El siguiente nodo que hay que revisar, o nullptr si no queda trabajo.
+         */
+        ConcurrentNode* rebalanceLocked(ConcurrentNode* parent, ConcurrentNode* node, bool& climb);
+
+        /**
+         * @brief Rota `node` hacia su lado liviano; `heavy` es el lado de `heavyChild`.
+         *
+         * @effect Toma el candado de `heavyChild` y, si hace falta una rotación doble, el del
+         *         nieto interior. Si el nieto interior es el desbalanceado, rebalancea primero
+         *         `heavyChild`.
+         *
+         * @require Los candados de `parent` y `node` deben estar tomados.
+         */
+        ConcurrentNode* rebalanceTowards(ConcurrentNode* parent, ConcurrentNode* node,
+            ConcurrentNode* heavyChild, int lightHeight, int heavy, bool& climb);
+
+        /**
+         * @brief Rotación simple que sube `heavyChild` al lugar de `node`.
+         *
+         * @effect Marca `node` como encogiéndose y `heavyChild` como creciendo mientras mueve
+         *         los enlaces, de modo que los lectores que pasan por ellos reintenten.
+         */
+        ConcurrentNode* rotateSingle(ConcurrentNode* parent, ConcurrentNode* node,
+            ConcurrentNode* heavyChild, int lightHeight, int outerHeight,
+            ConcurrentNode* inner, int innerHeight, int heavy, bool& climb);
+
+        /**
+         * @brief Rotación doble que sube el nieto interior `inner` al lugar de `node`.
+         */
+        ConcurrentNode* rotateDouble(ConcurrentNode* parent, ConcurrentNode* node,
+            ConcurrentNode* heavyChild, int lightHeight, int outerHeight,
+            ConcurrentNode* inner, int innerOuterHeight, int heavy, bool& climb);
+
+        /**
+         * @brief Elimina todos los nodos de un subárbol sin pasar por la reclamación por épocas.
+         */
+        void clear(ConcurrentNode* node);
+
+        /**
+         * @brief Cuenta los nodos de un subárbol, incluidos los de ruta.
+         */
+        size_t countNodes(ConcurrentNode* node);
+
+        /**
+         * @brief Llama a `visit` con las llaves presentes del subárbol en orden.
+         */
+        void visitPresent(ConcurrentNode* node, const std::function<void(int)>& visit);
+
+        /**
+         * @brief Agrega a `result` los nodos presentes del subárbol en preorden.
+         *
+         * @return La cantidad de nodos presentes del subárbol.
+         */
+        size_t toString(ConcurrentNode* node, std::string& result);
+
+    public:
+        /**
+         * @brief Constructs an empty tree.
+         */
+        ConcurrentAVLTree();
+
+        ConcurrentAVLTree(const ConcurrentAVLTree&) = delete;
+        ConcurrentAVLTree& operator=(const ConcurrentAVLTree&) = delete;
+
+        /**
+         * @brief Deletes every node still linked in the tree.
+         *
+         * @require No other thread may be using the tree.
+         */
+        ~ConcurrentAVLTree();
+
+        /**
+         * @brief Inserta un elemento; puede llamarse desde varios hilos a la vez.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente sin tomar ningún candado.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el árbol, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento; puede llamarse desde varios hilos a la vez.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Removes every element.
+         *
+         * @require No other thread may be using the tree.
+         */
+        void clear();
+
+        /**
+         * @brief Llama a `visit` con cada llave presente del árbol en orden ascendente.
+         *
+         * @require Ningún otro hilo puede estar modificando el árbol.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño del árbol y sus nodos presentes en preorden.
+         *
+         * @require Ningún otro hilo puede estar modificando el árbol.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes ocupados por los nodos enlazados, incluidos los de ruta.
+         *
+         * @require Ningún otro hilo puede estar modificando el árbol.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,74 @@
+// Copyright 2024 Randall Araya. ECCI-UCR. CC BY 4.0
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+// Helpers shared by the batched operations of the dictionaries
+namespace batch {
+
+// Number of lookups a pipelined batch keeps in flight at once
+const size_t PIPELINE_WIDTH = 16;
+
+// Ask the cache to start loading the line that holds an address
+/**
+ * Requires: Any address, including nullptr or one past the end of an array.
+ * Effects: Hints the processor to fetch the address into the cache for a
+ *          read. It never faults; on compilers without the builtin it does
+ *          nothing.
+ * Modifies: Nothing.
+ */
+inline void prefetch(const void* address) {
+#if defined(__GNUC__)
+  __builtin_prefetch(address);
+#else
+  (void) address;
+#endif
+}
+
+// Return the batch sorted in ascending order without repeated elements
+/**
+ * Requires: An array of `count` integer elements, in any order.
+ * Effects: Returns a sorted copy without duplicates. Batches that already
+ *          come in ascending order skip the sort.
+ * Modifies: Nothing.
+ */
+inline std::vector<int> sortedUnique(const int* elements, size_t count) {
+  std::vector<int> keys(elements, elements + count);
+  if (!std::is_sorted(keys.begin(), keys.end())) {
+    std::sort(keys.begin(), keys.end());
+  }
+  keys.erase(std::unique(keys.begin(), keys.end()), keys.end());
+  return keys;
+}
+
+// Return the batch as (element, position) pairs sorted by element
+/**
+ * Requires: An array of `count` integer elements, in any order.
+ * Effects: Returns every element paired with its position in the batch,
+ *          sorted by element, so that answers found in key order can be
+ *          written back to the position where they were asked.
+ * Modifies: Nothing.
+ */
+inline std::vector<std::pair<int, size_t>> sortedPositions(const int* elements,
+    size_t count) {
+  std::vector<std::pair<int, size_t>> entries(count);
+  for (size_t i = 0; i < count; ++i) {
+    entries[i] = std::make_pair(elements[i], i);
+  }
+  std::sort(entries.begin(), entries.end());
+  return entries;
+}
+
+// Compare a (element, position) pair against a bare element
+struct ElementLess {
+  bool operator()(const std::pair<int, size_t>& entry, int element) const {
+    return entry.first < element;
+  }
+  bool operator()(int element, const std::pair<int, size_t>& entry) const {
+    return element < entry.first;
+  }
+};
+
+}  // namespace batch
@@ -1,6 +1,9 @@
 // Copyright 2024 Randall Araya. ECCI-UCR. CC BY 4.0
 #pragma once
+#include <cstddef>
+#include <functional>
 #include <string>
+#include <vector>
 
 class Dict {
  public:
@@ -28,6 +31,60 @@ class Dict {
    */
   virtual void erase(int element) = 0;
 
+  // Virtual method to insert a batch of elements
+  /**
+   * Requires: An array of `count` integer elements, in any order.
+   * Effects: Inserts every element of the batch into the dictionary. The
+   *          default calls insert() once per element; dictionaries override
+   *          it to process the whole batch in fewer passes.
+   * Modifies: The structure of the dictionary.
+   */
+  virtual void insertMany(const int* elements, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      insert(elements[i]);
+    }
+  }
+
+  // Virtual method to check a batch of elements
+  /**
+   * Requires: An array of `count` integer elements, in any order.
+   * Effects: Sets found[i] to whether elements[i] is present in the
+   *          dictionary, resizing `found` to `count`.
+   * Modifies: found.
+   */
+  virtual void containsMany(const int* elements, size_t count,
+      std::vector<bool>& found) {
+    found.assign(count, false);
+    for (size_t i = 0; i < count; ++i) {
+      found[i] = contains(elements[i]);
+    }
+  }
+
+  // Virtual method to remove a batch of elements
+  /**
+   * Requires: An array of `count` integer elements, in any order.
+   * Effects: Removes every element of the batch that is present.
+   * Modifies: The structure of the dictionary.
+   */
+  virtual void eraseMany(const int* elements, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      erase(elements[i]);
+    }
+  }
+
+  // Virtual method to visit every element
+  /**
+   * Requires: A function that does not modify the dictionary.
+   * Effects: Calls visit once with every element, in any order, and returns
+   *          true. The default returns false without calling it, for
+   *          dictionaries that cannot list their elements.
+   * Modifies: Nothing.
+   */
+  virtual bool forEachElement(const std::function<void(int)>& visit) {
+    (void) visit;
+    return false;
+  }
+
   // Pure virtual method to print the dictionary
   /**
    * Requires: Nothing.
@@ -36,6 +93,15 @@ class Dict {
    */
   virtual std::string toString() = 0;
 
+  // Pure virtual method to report the memory held by the dictionary
+  /**
+   * Requires: Nothing.
+   * Effects: Returns the number of bytes reserved for the stored elements
+   *          (nodes, pools or arrays), not counting the dictionary object.
+   * Modifies: Nothing.
+   */
+  virtual size_t memoryUsage() = 0;
+
   // Virtual destructor
   /**
    * Requires: Nothing.
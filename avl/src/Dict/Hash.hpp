@@ -0,0 +1,25 @@
+// Copyright 2024 Randall Araya. ECCI-UCR. CC BY 4.0
+#pragma once
+#include <cstdint>
+
+// Hashing shared by the dictionaries that spread keys by their hash
+namespace hashing {
+
+// Mix the bits of a key with the MurmurHash3 finalizer
+/**
+ * Requires: Any integer key.
+ * Effects: Returns a 64-bit hash where every bit of the key affects every
+ *          bit of the result, so any slice of it can pick a slot or a block.
+ * Modifies: Nothing.
+ */
+inline uint64_t mix(int key) {
+  uint64_t hashed = static_cast<uint32_t>(key);
+  hashed ^= hashed >> 33;
+  hashed *= 0xff51afd7ed558ccdULL;
+  hashed ^= hashed >> 33;
+  hashed *= 0xc4ceb9fe1a85ec53ULL;
+  hashed ^= hashed >> 33;
+  return hashed;
+}
+
+}  // namespace hashing
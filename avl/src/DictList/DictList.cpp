@@ -1,6 +1,9 @@
 // Copyright 2024 Randall Araya. ECCI-UCR. CC BY 4.0
 #include "DictList.hpp"
 
+#include "../Dict/Batch.hpp"
+#include "../Serialization/Snapshot.hpp"
+
 // Node constructor
 DictList::Node::Node(int element) : element(element), next(nullptr) {}
 
@@ -83,6 +86,64 @@ void DictList::erase(int element) {
   delete current;
 }
 
+void DictList::insertMany(const int* elements, size_t count) {
+  std::vector<int> keys = batch::sortedUnique(elements, count);
+
+  // Link that will point to the next new node
+  Node** link = &head;
+  for (int key : keys) {
+    while (*link != nullptr && (*link)->element < key) {
+      link = &(*link)->next;
+    }
+    if (*link != nullptr && (*link)->element == key) {
+      continue;
+    }
+    Node* newNode = new Node(key);
+    newNode->next = *link;
+    *link = newNode;
+    link = &newNode->next;
+  }
+}
+
+void DictList::containsMany(const int* elements, size_t count,
+    std::vector<bool>& found) {
+  std::vector<std::pair<int, size_t>> entries =
+      batch::sortedPositions(elements, count);
+  found.assign(count, false);
+
+  Node* current = head;
+  for (const std::pair<int, size_t>& entry : entries) {
+    while (current != nullptr && current->element < entry.first) {
+      current = current->next;
+    }
+    found[entry.second] = current != nullptr &&
+        current->element == entry.first;
+  }
+}
+
+void DictList::eraseMany(const int* elements, size_t count) {
+  std::vector<int> keys = batch::sortedUnique(elements, count);
+
+  Node** link = &head;
+  for (int key : keys) {
+    while (*link != nullptr && (*link)->element < key) {
+      link = &(*link)->next;
+    }
+    if (*link != nullptr && (*link)->element == key) {
+      Node* removed = *link;
+      *link = removed->next;
+      delete removed;
+    }
+  }
+}
+
+bool DictList::forEachElement(const std::function<void(int)>& visit) {
+  for (Node* current = head; current != nullptr; current = current->next) {
+    visit(current->element);
+  }
+  return true;
+}
+
 std::string DictList::toString() {
   Node* current = head;
   std::string result = "";
@@ -100,6 +161,46 @@ std::string DictList::toString() {
   return result;
 }
 
+size_t DictList::memoryUsage() {
+  size_t nodes = 0;
+  for (Node* current = head; current != nullptr; current = current->next) {
+    ++nodes;
+  }
+  return nodes * sizeof(Node);
+}
+
+bool DictList::saveSnapshot(const char* path) {
+  FILE* file = std::fopen(path, "wb");
+  if (file == nullptr) {
+    return false;
+  }
+  bool written;
+  {
+    SnapshotWriter snapshot(file);
+    for (Node* current = head; current != nullptr; current = current->next) {
+      snapshot.add(current->element);
+    }
+    written = snapshot.finish();
+  }
+  return std::fclose(file) == 0 && written;
+}
+
+void DictList::loadSnapshot(const char* path) {
+  MappedSnapshot snapshot(path);
+
+  // Free the previous nodes, then link the keys in the order they are stored
+  while (head != nullptr) {
+    Node* next = head->next;
+    delete head;
+    head = next;
+  }
+  Node** link = &head;
+  for (size_t i = 0; i < snapshot.count(); ++i) {
+    *link = new Node(snapshot.keys()[i]);
+    link = &(*link)->next;
+  }
+}
+
 DictList::~DictList() {
   Node* current = head;
   while (current != nullptr) {
@@ -53,6 +53,41 @@ class DictList : public Dict{
    */
   void erase(int element) override;
 
+  // Insert a batch of elements
+  /**
+   * Requires: An array of `count` integer elements, in any order.
+   * Effects: Sorts the batch and merges it into the list in a single pass.
+   * Modifies: The list, by inserting the missing elements.
+   */
+  void insertMany(const int* elements, size_t count) override;
+
+  // Check a batch of elements
+  /**
+   * Requires: An array of `count` integer elements, in any order.
+   * Effects: Sorts the batch and answers it with a single walk of the list,
+   *          storing in found[i] whether elements[i] exists.
+   * Modifies: found.
+   */
+  void containsMany(const int* elements, size_t count,
+      std::vector<bool>& found) override;
+
+  // Remove a batch of elements
+  /**
+   * Requires: An array of `count` integer elements, in any order.
+   * Effects: Sorts the batch and removes its elements in a single pass.
+   * Modifies: The list, by removing the nodes that are found.
+   */
+  void eraseMany(const int* elements, size_t count) override;
+
+  // Visit every element
+  /**
+   * Requires: A function that does not modify the list.
+   * Effects: Walks the list calling visit with every element in ascending
+   *          order, and returns true.
+   * Modifies: Nothing.
+   */
+  bool forEachElement(const std::function<void(int)>& visit) override;
+
   // Return a string representation of the dictionary
   /**
    * Requires: Nothing.
@@ -61,6 +96,34 @@ class DictList : public Dict{
    */
   std::string toString() override;
 
+  // Save the list to a binary snapshot file
+  /**
+   * Requires: A path where a file can be written.
+   * Effects: Writes a header with the number of keys and their checksum,
+   *          followed by the keys in ascending order. Returns false if the
+   *          file could not be written.
+   * Modifies: The file at path.
+   */
+  bool saveSnapshot(const char* path);
+
+  // Replace the list with the contents of a snapshot file
+  /**
+   * Requires: A path to a file written by saveSnapshot.
+   * Effects: Maps the file with mmap, validates it and links one node per
+   *          key in a single pass. Throws std::runtime_error if the file is
+   *          missing or is not a valid snapshot.
+   * Modifies: The list, which loses its previous nodes.
+   */
+  void loadSnapshot(const char* path);
+
+  // Return the bytes used by the nodes of the list
+  /**
+   * Requires: Nothing.
+   * Effects: Walks the list and returns the memory held by its nodes.
+   * Modifies: Nothing.
+   */
+  size_t memoryUsage() override;
+
   // Destructor
   /**
    * Requires: Nothing.
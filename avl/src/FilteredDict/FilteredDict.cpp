@@ -0,0 +1,151 @@
+#include "FilteredDict.hpp"
+#include <algorithm>
+#include "../Dict/Batch.hpp"
+#include "../Dict/Hash.hpp"
+#include "../Simd/BloomBlock.hpp"
+
+FilteredDict::FilteredDict(Dict& dict, size_t expectedKeys)
+    : dict(dict)
+    , expectedKeys(std::max<size_t>(expectedKeys, 1))
+    , keysAdded(0)
+    , erases(0)
+    , canRebuild(true)
+    , rejected(0) {
+    blocks.assign((this->expectedKeys * BITS_PER_KEY + BLOCK_BITS - 1) / BLOCK_BITS, Block());
+    rebuild();
+}
+
+size_t FilteredDict::blockIndex(uint64_t hashed) const {
+    // Multiplicar y quedarse con la parte alta reparte los bloques sin usar módulo
+    return ((hashed >> 32) * blocks.size()) >> 32;
+}
+
+void FilteredDict::addKey(int key) {
+    uint64_t hashed = hashing::mix(key);
+    simd::bloomInsert(blocks[blockIndex(hashed)].words, static_cast<uint32_t>(hashed));
+    keysAdded++;
+}
+
+bool FilteredDict::mayContain(int key) const {
+    uint64_t hashed = hashing::mix(key);
+    return simd::bloomCheck(blocks[blockIndex(hashed)].words, static_cast<uint32_t>(hashed));
+}
+
+size_t FilteredDict::capacity() const {
+    return blocks.size() * BLOCK_BITS / BITS_PER_KEY;
+}
+
+void FilteredDict::rebuildIfStale() {
+    // Cada reconstrucción cuesta O(n), pero solo ocurre después de Θ(n) escrituras
+    if (canRebuild && (keysAdded > capacity() || erases * 4 > keysAdded)) {
+        rebuild();
+    }
+}
+
+void FilteredDict::rebuild() {
+    std::vector<int> keys;
+    if (!dict.forEachElement([&keys](int key) { keys.push_back(key); })) {
+        canRebuild = false;
+        return;
+    }
+
+    // El doble de espacio deja crecer al diccionario antes de la próxima reconstrucción
+    size_t sized = std::max(expectedKeys, 2 * keys.size());
+    blocks.assign((sized * BITS_PER_KEY + BLOCK_BITS - 1) / BLOCK_BITS, Block());
+    keysAdded = 0;
+    erases = 0;
+    for (int key : keys) {
+        addKey(key);
+    }
+}
+
+void FilteredDict::insert(int element) {
+    // El filtro no tiene falsos negativos: si descarta la llave, es nueva
+    bool isNew = !mayContain(element) || !dict.contains(element);
+    dict.insert(element);
+    if (isNew) {
+        addKey(element);
+        rebuildIfStale();
+    }
+}
+
+bool FilteredDict::contains(int element) {
+    if (!mayContain(element)) {
+        rejected++;
+        return false;
+    }
+    return dict.contains(element);
+}
+
+void FilteredDict::erase(int element) {
+    if (!mayContain(element)) {
+        return;
+    }
+    dict.erase(element);
+    erases++;
+    rebuildIfStale();
+}
+
+void FilteredDict::insertMany(const int* elements, size_t count) {
+    // Contar cada llave una sola vez, y solo si el diccionario no la tenía
+    std::vector<int> fresh;
+    for (int key : batch::sortedUnique(elements, count)) {
+        if (!mayContain(key) || !dict.contains(key)) {
+            fresh.push_back(key);
+        }
+    }
+    dict.insertMany(elements, count);
+    for (int key : fresh) {
+        addKey(key);
+    }
+    rebuildIfStale();
+}
+
+void FilteredDict::containsMany(const int* elements, size_t count, std::vector<bool>& found) {
+    found.assign(count, false);
+    std::vector<int> candidates;
+    std::vector<size_t> positions;
+    for (size_t i = 0; i < count; ++i) {
+        if (mayContain(elements[i])) {
+            candidates.push_back(elements[i]);
+            positions.push_back(i);
+        } else {
+            rejected++;
+        }
+    }
+
+    std::vector<bool> candidateFound;
+    dict.containsMany(candidates.data(), candidates.size(), candidateFound);
+    for (size_t i = 0; i < candidates.size(); ++i) {
+        found[positions[i]] = candidateFound[i];
+    }
+}
+
+void FilteredDict::eraseMany(const int* elements, size_t count) {
+    // Como en erase, las llaves que el filtro descarta no estaban y no cuentan
+    std::vector<int> candidates;
+    for (int key : batch::sortedUnique(elements, count)) {
+        if (mayContain(key)) {
+            candidates.push_back(key);
+        }
+    }
+    dict.eraseMany(candidates.data(), candidates.size());
+    erases += candidates.size();
+    rebuildIfStale();
+}
+
+bool FilteredDict::forEachElement(const std::function<void(int)>& visit) {
+    return dict.forEachElement(visit);
+}
+
+size_t FilteredDict::rejectedCount() const {
+    return rejected;
+}
+
+std::string FilteredDict::toString() {
+    return dict.toString();
+}
+
+size_t FilteredDict::memoryUsage() {
+    return dict.memoryUsage() + blocks.capacity() * sizeof(Block);
+}
@@ -0,0 +1,156 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../Dict/Dict.h"
+
+/**
+ * @class FilteredDict
+ * @brief Puts a Bloom filter in front of any dictionary so that most searches for missing
+ *        keys are answered without touching it.
+ *
+ * The filter is split into blocks of 256 bits, 32 bytes, and every key hashes to a
+ * single block where it sets one bit in each of its eight words (see
+ * `simd::bloomInsert`). A search therefore reads one cache line and tests the eight bits
+ * with a few SSE2 instructions, and only the keys that pass are looked up in the wrapped
+ * dictionary. With `BITS_PER_KEY` bits per key at most about 1% of the missing keys get
+ * through.
+ *
+ * Insertions set the bits of the key right away, so the filter never rejects a key that
+ * is present. A Bloom filter cannot forget a key, though: erased keys keep passing until
+ * the filter is rebuilt from the keys of the dictionary, which happens after enough erases
+ * and whenever the filter holds more keys than it was sized for. Rebuilding lists the
+ * keys with `Dict::forEachElement`, which every dictionary of this project implements; a
+ * dictionary that keeps the default, and cannot list its keys, keeps the filter it has,
+ * which stays correct but lets more missing keys through as it fills.
+ */
+class FilteredDict : public Dict {
+    private:
+        /// Filter bits per key when the filter is sized.
+        static const size_t BITS_PER_KEY = 12;
+        /// Bits of a block.
+        static const size_t BLOCK_BITS = 256;
+
+        /**
+         * @struct Block
+         * @brief Eight 32-bit words, aligned so a block never straddles a cache line.
+         */
+        struct alignas(32) Block {
+            uint32_t words[8];
+        };
+
+        Dict& dict;                /// The wrapped dictionary, owned by the caller.
+        std::vector<Block> blocks; /// The filter.
+        size_t expectedKeys;       /// Keys the filter is sized for at least.
+        size_t keysAdded;          /// Keys hashed into the filter since it was built.
+        size_t erases;             /// Erases since the filter was built.
+        bool canRebuild;           /// Whether the dictionary can list its keys.
+        size_t rejected;           /// Searches answered by the filter alone.
+
+        /**
+         * @brief Devuelve la posición del bloque de un hash, usando sus 32 bits altos.
+         */
+        size_t blockIndex(uint64_t hashed) const;
+
+        /**
+         * @brief Marca la llave en el filtro.
+         */
+        void addKey(int key);
+
+        /**
+         * @brief Devuelve false si la llave seguro no está en el diccionario.
+         */
+        bool mayContain(int key) const;
+
+        /**
+         * @brief Devuelve las llaves que caben en el filtro antes de reconstruirlo.
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Reconstruye el filtro si se llenó o si acumuló demasiados borrados.
+         */
+        void rebuildIfStale();
+
+        /**
+         * @brief Arma un filtro nuevo con las llaves del diccionario, del doble de su tamaño.
+         *
+         * @effect Si el diccionario no puede listar sus llaves, deja el filtro como está y no
+         *         vuelve a intentarlo.
+         */
+        void rebuild();
+
+    public:
+        /**
+         * @brief Wraps `dict`, which must outlive the wrapper, and builds the filter from its keys.
+         *
+         * @require `dict` must be empty if it cannot list its keys with `forEachElement`.
+         *
+         * @param expectedKeys Keys the filter is sized for until the dictionary grows past them.
+         */
+        explicit FilteredDict(Dict& dict, size_t expectedKeys = 1 << 16);
+
+        FilteredDict(const FilteredDict&) = delete;
+        FilteredDict& operator=(const FilteredDict&) = delete;
+
+        /**
+         * @brief Inserta un elemento en el diccionario y, si no estaba, lo marca en el filtro.
+         *
+         * @effect Solo consulta al diccionario si el filtro no descarta el elemento.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente, sin tocar el diccionario si el filtro
+         *        lo descarta.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento del diccionario; el filtro lo olvida en la próxima reconstrucción.
+         *
+         * @effect Si el filtro descarta el elemento no estaba, y no cuenta como eliminación.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Inserta un lote en el diccionario con una sola llamada y marca en el filtro
+         *        las llaves que no estaban.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Verifica un lote pasando al diccionario solo los elementos que el filtro no descarta.
+         */
+        void containsMany(const int* elements, size_t count, std::vector<bool>& found) override;
+
+        /**
+         * @brief Elimina un lote del diccionario con una sola llamada.
+         *
+         * @effect Pasa al diccionario cada llave una sola vez, y solo si el filtro no la
+         *         descarta; solo esas cuentan como eliminaciones.
+         */
+        void eraseMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Lista los elementos del diccionario envuelto.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve las búsquedas que el filtro respondió sin consultar el diccionario.
+         */
+        size_t rejectedCount() const;
+
+        /**
+         * @brief Devuelve la representación del diccionario envuelto.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve la memoria del diccionario envuelto más la del filtro.
+         */
+        size_t memoryUsage() override;
+};
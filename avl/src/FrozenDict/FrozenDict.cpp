@@ -0,0 +1,154 @@
+#include "FrozenDict.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <sstream>
+#include <stdexcept>
+#include "../Dict/Batch.hpp"
+#include "../Serialization/BufferedWriter.hpp"
+
+/**
+ * @brief Cuenta los bits en 1 consecutivos desde el menos significativo.
+ */
+static int trailingOnes(size_t value) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(~static_cast<unsigned long long>(value));
+#else
+    int ones = 0;
+    while (value & 1) {
+        value >>= 1;
+        ones++;
+    }
+    return ones;
+#endif
+}
+
+/// Alineación del arreglo: una línea de caché.
+static const std::align_val_t LINE_ALIGNMENT{64};
+
+FrozenDict::FrozenDict(const int* sorted, size_t count)
+    : keys(nullptr)
+    , size(0) {
+    std::vector<int> unique;
+    for (size_t i = 1; i < count; ++i) {
+        if (sorted[i - 1] >= sorted[i]) {
+            unique = batch::sortedUnique(sorted, count);
+            sorted = unique.data();
+            count = unique.size();
+            break;
+        }
+    }
+
+    keys = allocate(count);
+    size = count;
+    fill(sorted, 0, 1);
+}
+
+FrozenDict::FrozenDict(FrozenDict&& other) noexcept
+    : keys(other.keys)
+    , size(other.size) {
+    other.keys = nullptr;
+    other.size = 0;
+}
+
+FrozenDict::~FrozenDict() {
+    ::operator delete[](keys, LINE_ALIGNMENT);
+}
+
+int* FrozenDict::allocate(size_t size) {
+    // Redondear a líneas completas para que cada línea tenga 16 llaves válidas o relleno
+    size_t slots = (size + 1 + KEYS_PER_LINE - 1) / KEYS_PER_LINE * KEYS_PER_LINE;
+    return static_cast<int*>(::operator new[](slots * sizeof(int), LINE_ALIGNMENT));
+}
+
+size_t FrozenDict::fill(const int* sorted, size_t next, size_t k) {
+    // El recorrido en orden del árbol implícito visita las posiciones en orden ascendente
+    if (k <= size) {
+        next = fill(sorted, next, 2 * k);
+        keys[k] = sorted[next++];
+        next = fill(sorted, next, 2 * k + 1);
+    }
+    return next;
+}
+
+size_t FrozenDict::lowerBound(int element) const {
+    // Dirección de los 16 descendientes de `k` cuatro niveles abajo; se calcula como
+    // entero porque puede caer fuera del arreglo, y un prefetch ahí no tiene efecto
+    const uintptr_t base = reinterpret_cast<uintptr_t>(keys);
+    const uintptr_t lineBytes = KEYS_PER_LINE * sizeof(int);
+
+    size_t k = 1;
+    while (k <= size) {
+        batch::prefetch(reinterpret_cast<const void*>(base + k * lineBytes));
+        k = 2 * k + (keys[k] < element);
+    }
+    // Los bits de `k` son el camino; quitar los pasos a la derecha del final y el último
+    // a la izquierda deja el nodo donde la búsqueda giró por última vez a la izquierda
+    return k >> (trailingOnes(k) + 1);
+}
+
+void FrozenDict::insert(int) {
+    throw std::logic_error("FrozenDict: the dictionary is immutable");
+}
+
+bool FrozenDict::contains(int element) {
+    size_t k = lowerBound(element);
+    return k != 0 && keys[k] == element;
+}
+
+void FrozenDict::erase(int) {
+    throw std::logic_error("FrozenDict: the dictionary is immutable");
+}
+
+void FrozenDict::insertMany(const int*, size_t) {
+    throw std::logic_error("FrozenDict: the dictionary is immutable");
+}
+
+void FrozenDict::eraseMany(const int*, size_t) {
+    throw std::logic_error("FrozenDict: the dictionary is immutable");
+}
+
+size_t FrozenDict::count() const {
+    return size;
+}
+
+bool FrozenDict::forEachElement(const std::function<void(int)>& visit) {
+    for (size_t k = 1; k <= size; ++k) {
+        visit(keys[k]);
+    }
+    return true;
+}
+
+std::string FrozenDict::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writer.write("Size: ");
+        writer.write(static_cast<int>(size));
+        writer.write("\nElements:\n");
+
+        // Recorrido en orden sin pila: el sucesor se obtiene de los bits de la posición
+        size_t k = 1;
+        while (2 * k <= size) {
+            k *= 2;
+        }
+        for (size_t i = 0; i < size; ++i) {
+            writer.write(keys[k]);
+            writer.write(" ");
+            if (2 * k + 1 <= size) {
+                k = 2 * k + 1;
+                while (2 * k <= size) {
+                    k *= 2;
+                }
+            } else {
+                k >>= trailingOnes(k) + 1;
+            }
+        }
+        writer.write("\n");
+    }
+    return stream.str();
+}
+
+size_t FrozenDict::memoryUsage() {
+    return (size + 1 + KEYS_PER_LINE - 1) / KEYS_PER_LINE * KEYS_PER_LINE * sizeof(int);
+}
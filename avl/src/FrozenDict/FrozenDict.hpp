@@ -0,0 +1,119 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+#include "../Dict/Dict.h"
+
+/**
+ * @class FrozenDict
+ * @brief An immutable dictionary stored as one contiguous array in Eytzinger order.
+ *
+ * The keys are laid out as a complete binary search tree in breadth-first order, with the
+ * root at index 1 and the children of `k` at `2k` and `2k + 1`. A search touches the same
+ * nodes as in a balanced tree, but without pointers: the next index is computed with a
+ * comparison turned into 0 or 1, so the loop has no branch to mispredict. The array is
+ * aligned to a cache line, and since the sixteen descendants four levels below `k` are
+ * contiguous, the search prefetches them while it works on the current level.
+ *
+ * It is built with `AVLTree::freeze()` or from any ascending array, such as the keys of a
+ * `MappedSnapshot`. `insert` and `erase` throw `std::logic_error`.
+ */
+class FrozenDict : public Dict {
+    private:
+        int* keys;    /// Eytzinger array; `keys[0]` is unused so the root is at 1.
+        size_t size;  /// Number of keys.
+
+        /// Ints per cache line, the number of descendants prefetched four levels ahead.
+        static const size_t KEYS_PER_LINE = 16;
+
+        /**
+         * @brief Reserva el arreglo alineado a una línea de caché con espacio para `size` llaves.
+         */
+        static int* allocate(size_t size);
+
+        /**
+         * @brief Copia en orden las llaves de `sorted` al subárbol implícito que empieza en `k`.
+         *
+         * @return La posición de `sorted` que sigue a la última llave copiada.
+         */
+        size_t fill(const int* sorted, size_t next, size_t k);
+
+        /**
+         * @brief Devuelve la posición de la primera llave mayor o igual que `element`, o 0 si
+         *        todas son menores.
+         */
+        size_t lowerBound(int element) const;
+
+    public:
+        /**
+         * @brief Builds the dictionary from `count` keys.
+         *
+         * @param sorted The keys; if they are not strictly ascending a sorted copy without
+         *        repeated keys is used instead.
+         * @param count The number of keys.
+         */
+        FrozenDict(const int* sorted, size_t count);
+
+        FrozenDict(const FrozenDict&) = delete;
+        FrozenDict& operator=(const FrozenDict&) = delete;
+
+        /**
+         * @brief Takes over the array of `other`, which is left empty.
+         */
+        FrozenDict(FrozenDict&& other) noexcept;
+
+        /**
+         * @brief Frees the array.
+         */
+        ~FrozenDict();
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente con una búsqueda sin saltos.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el diccionario, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void eraseMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Devuelve la cantidad de llaves.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Llama a `visit` con cada llave en el orden del arreglo, no en orden ascendente.
+         *
+         * @return true, porque el diccionario siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño y las llaves en orden ascendente.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes del arreglo, incluidos la posición 0 y el relleno.
+         */
+        size_t memoryUsage() override;
+};
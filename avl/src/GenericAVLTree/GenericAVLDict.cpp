@@ -0,0 +1,30 @@
+#include "GenericAVLDict.hpp"
+
+void GenericAVLDict::insert(int element) {
+    keys.insert(element);
+}
+
+bool GenericAVLDict::contains(int element) {
+    return keys.contains(element);
+}
+
+void GenericAVLDict::erase(int element) {
+    keys.erase(element);
+}
+
+bool GenericAVLDict::forEachElement(const std::function<void(int)>& visit) {
+    keys.forEach(visit);
+    return true;
+}
+
+std::string GenericAVLDict::toString() {
+    return keys.toString();
+}
+
+size_t GenericAVLDict::memoryUsage() {
+    return keys.memoryUsage();
+}
+
+GenericAVLTree<int>& GenericAVLDict::tree() {
+    return keys;
+}
@@ -0,0 +1,55 @@
+#pragma once
+#include <string>
+#include "../Dict/Dict.h"
+#include "GenericAVLTree.hpp"
+
+/**
+ * @class GenericAVLDict
+ * @brief Exposes a `GenericAVLTree<int>` through the `Dict` interface.
+ *
+ * Callers that hold a `Dict&` keep paying one virtual call per operation, but the
+ * tree underneath is fully inlined. Code that knows the concrete type can use
+ * `tree()` to skip the virtual dispatch altogether.
+ */
+class GenericAVLDict final : public Dict {
+    private:
+        GenericAVLTree<int> keys; /// The tree that stores the keys.
+
+    public:
+        /**
+         * @brief Inserta un elemento en el árbol.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en el árbol.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento del árbol si está presente.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol en orden ascendente.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño del árbol y sus nodos en preorden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes ocupados por los nodos del árbol.
+         */
+        size_t memoryUsage() override;
+
+        /**
+         * @brief Gives direct, non-virtual access to the underlying tree.
+         */
+        GenericAVLTree<int>& tree();
+};
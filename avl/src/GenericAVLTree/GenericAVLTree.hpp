@@ -0,0 +1,392 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <utility>
+
+/**
+ * @class GenericAVLTree
+ * @brief A header-only AVL tree over any key type, without virtual dispatch.
+ *
+ * It follows the same algorithms as `AVLTree` (parent pointers, rebalancing from the
+ * changed node up to the root), but every comparison goes through `Compare` and every
+ * node through `Allocator`, both known at compile time, so the hot paths inline fully.
+ * `GenericAVLDict` adapts it to the `Dict` interface for the existing callers.
+ *
+ * @tparam Key The type of the keys, which must be copyable.
+ * @tparam Compare A strict weak ordering over `Key`.
+ * @tparam Allocator An allocator of `Key`, rebound internally to allocate whole nodes.
+ */
+template <typename Key, typename Compare = std::less<Key>,
+    typename Allocator = std::allocator<Key>>
+class GenericAVLTree {
+    protected:
+        /**
+         * @struct GenericNode
+         * @brief A node of the generic tree; the same layout as `Node` with a templated key.
+         */
+        struct GenericNode {
+            explicit GenericNode(const Key& data)
+                : data(data), height(0), left(nullptr), right(nullptr), parent(nullptr) {
+            };
+            Key data;
+            int height;
+            GenericNode* left;
+            GenericNode* right;
+            GenericNode* parent;
+        };
+
+        using NodeAllocator =
+            typename std::allocator_traits<Allocator>::template rebind_alloc<GenericNode>;
+        using NodeTraits = std::allocator_traits<NodeAllocator>;
+
+        GenericNode* root;       /// Pointer to the root node of the tree.
+        size_t size;             /// The number of nodes in the tree.
+        Compare less;            /// The ordering of the keys.
+        NodeAllocator allocator; /// Allocates and constructs the nodes.
+
+        /**
+         * @brief Allocates and constructs a node holding `element`.
+         */
+        GenericNode* createNode(const Key& element) {
+            GenericNode* node = NodeTraits::allocate(allocator, 1);
+            NodeTraits::construct(allocator, node, element);
+            return node;
+        }
+
+        /**
+         * @brief Destroys and deallocates a node that is no longer linked.
+         */
+        void destroyNode(GenericNode* node) {
+            NodeTraits::destroy(allocator, node);
+            NodeTraits::deallocate(allocator, node, 1);
+        }
+
+        /**
+         * @brief Deletes every node of a subtree.
+         */
+        void clear(GenericNode* node) {
+            if (node == nullptr) {
+                return;
+            }
+            clear(node->left);
+            clear(node->right);
+            destroyNode(node);
+        }
+
+        /**
+         * @brief Devuelve la altura de un nodo, -1 si es nulo.
+         */
+        static int height(const GenericNode* node) {
+            return (node == nullptr) ? -1 : node->height;
+        }
+
+        /**
+         * @brief Devuelve altura(izquierdo) - altura(derecho), 0 si el nodo es nulo.
+         */
+        static int getBalance(const GenericNode* node) {
+            if (node == nullptr) {
+                return 0;
+            }
+            return height(node->left) - height(node->right);
+        }
+
+        /**
+         * @brief Rotación simple a la derecha; igual que `AVLTree::rightRotate`.
+         */
+        GenericNode* rightRotate(GenericNode* y) {
+            GenericNode* x = y->left;
+            GenericNode* T2 = x->right;
+
+            x->right = y;
+            y->left = T2;
+            x->parent = y->parent;
+            y->parent = x;
+            if (T2 != nullptr) {
+                T2->parent = y;
+            }
+
+            y->height = std::max(height(y->left), height(y->right)) + 1;
+            x->height = std::max(height(x->left), height(x->right)) + 1;
+            return x;
+        }
+
+        /**
+         * @brief Rotación simple a la izquierda; igual que `AVLTree::leftRotate`.
+         */
+        GenericNode* leftRotate(GenericNode* x) {
+            GenericNode* y = x->right;
+            GenericNode* T2 = y->left;
+
+            y->left = x;
+            x->right = T2;
+            y->parent = x->parent;
+            x->parent = y;
+            if (T2 != nullptr) {
+                T2->parent = x;
+            }
+
+            x->height = std::max(height(x->left), height(x->right)) + 1;
+            y->height = std::max(height(y->left), height(y->right)) + 1;
+            return y;
+        }
+
+        /**
+         * @brief Cuelga `subtree` del padre de `node` en su lugar, o lo hace raíz.
+         */
+        void replaceChild(GenericNode* node, GenericNode* subtree) {
+            if (subtree->parent == nullptr) {
+                root = subtree;
+            } else if (subtree->parent->left == node) {
+                subtree->parent->left = subtree;
+            } else {
+                subtree->parent->right = subtree;
+            }
+        }
+
+        /**
+         * @brief Rebalancea desde `node` hasta la raíz; igual que `AVLTree::balance`.
+         */
+        void balance(GenericNode* node) {
+            while (node != nullptr) {
+                node->height = std::max(height(node->left), height(node->right)) + 1;
+                int balanceFactor = getBalance(node);
+
+                if (balanceFactor > 1) {
+                    // Caso Left Right: primero rotar el hijo izquierdo
+                    if (getBalance(node->left) < 0) {
+                        node->left = leftRotate(node->left);
+                    }
+                    replaceChild(node, rightRotate(node));
+                } else if (balanceFactor < -1) {
+                    // Caso Right Left: primero rotar el hijo derecho
+                    if (getBalance(node->right) > 0) {
+                        node->right = rightRotate(node->right);
+                    }
+                    replaceChild(node, leftRotate(node));
+                }
+
+                node = node->parent;
+            }
+        }
+
+        /**
+         * @brief Devuelve el nodo con la llave `element`, o nullptr si no está.
+         */
+        GenericNode* find(const Key& element) const {
+            GenericNode* current = root;
+            while (current != nullptr) {
+                if (less(element, current->data)) {
+                    current = current->left;
+                } else if (less(current->data, element)) {
+                    current = current->right;
+                } else {
+                    return current;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Agrega a `stream` los nodos del subárbol en preorden.
+         */
+        void toString(const GenericNode* node, std::ostringstream& stream) const {
+            if (node == nullptr) {
+                return;
+            }
+            stream << "Node: " << node->data << "-->";
+            if (node->parent != nullptr) {
+                stream << " Parent: " << node->parent->data;
+            } else {
+                stream << " Parent: None";
+            }
+            stream << " Height: " << node->height + 1 << "\n";
+            toString(node->left, stream);
+            toString(node->right, stream);
+        }
+
+    public:
+        /**
+         * @brief Constructs an empty tree.
+         *
+         * @param compare The ordering of the keys.
+         * @param alloc The allocator, rebound to allocate nodes.
+         */
+        explicit GenericAVLTree(const Compare& compare = Compare(),
+                const Allocator& alloc = Allocator())
+            : root(nullptr)
+            , size(0)
+            , less(compare)
+            , allocator(alloc) {
+        }
+
+        GenericAVLTree(const GenericAVLTree&) = delete;
+        GenericAVLTree& operator=(const GenericAVLTree&) = delete;
+
+        /**
+         * @brief Deletes every node of the tree.
+         */
+        ~GenericAVLTree() {
+            clear();
+        }
+
+        /**
+         * @brief Inserta una llave y rebalancea el camino hasta la raíz.
+         *
+         * @modifies Agrega un nodo si la llave no estaba y aumenta `size`.
+         *
+         * @param element La llave a insertar.
+         */
+        void insert(const Key& element) {
+            GenericNode* parent = nullptr;
+            GenericNode* current = root;
+            bool goLeft = false;
+
+            while (current != nullptr) {
+                parent = current;
+                if (less(element, current->data)) {
+                    goLeft = true;
+                    current = current->left;
+                } else if (less(current->data, element)) {
+                    goLeft = false;
+                    current = current->right;
+                } else {
+                    return; // element already exists in the tree
+                }
+            }
+
+            GenericNode* newNode = createNode(element);
+            newNode->parent = parent;
+            if (parent == nullptr) {
+                root = newNode;
+            } else if (goLeft) {
+                parent->left = newNode;
+            } else {
+                parent->right = newNode;
+            }
+            size++;
+            balance(parent);
+        }
+
+        /**
+         * @brief Verifica si una llave está en el árbol.
+         *
+         * @param element La llave a buscar.
+         * @return true si la llave está en el árbol, false en caso contrario.
+         */
+        bool contains(const Key& element) const {
+            return find(element) != nullptr;
+        }
+
+        /**
+         * @brief Elimina una llave y rebalancea el árbol; igual que `AVLTree::erase`.
+         *
+         * @effect Si el nodo tiene dos hijos, recibe la llave de su sucesor en orden y se
+         *         elimina el sucesor.
+         *
+         * @param element La llave a eliminar.
+         */
+        void erase(const Key& element) {
+            GenericNode* current = find(element);
+            if (current == nullptr) {
+                return;
+            }
+
+            if (current->left != nullptr && current->right != nullptr) {
+                GenericNode* successor = current->right;
+                while (successor->left != nullptr) {
+                    successor = successor->left;
+                }
+                current->data = std::move(successor->data);
+                current = successor;
+            }
+
+            GenericNode* child = (current->left != nullptr) ? current->left : current->right;
+            GenericNode* parent = current->parent;
+            if (child != nullptr) {
+                child->parent = parent;
+            }
+            if (parent == nullptr) {
+                root = child;
+            } else if (parent->left == current) {
+                parent->left = child;
+            } else {
+                parent->right = child;
+            }
+
+            destroyNode(current);
+            size--;
+            balance(parent);
+        }
+
+        /**
+         * @brief Removes every key from the tree.
+         */
+        void clear() {
+            clear(root);
+            root = nullptr;
+            size = 0;
+        }
+
+        /**
+         * @brief Devuelve la cantidad de llaves del árbol.
+         */
+        size_t count() const {
+            return size;
+        }
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol en orden ascendente.
+         *
+         * @effect Sigue los punteros al padre para avanzar al sucesor, sin reservar memoria.
+         *
+         * @require `visit` no debe insertar ni eliminar llaves del árbol.
+         */
+        template <typename Visitor>
+        void forEach(Visitor visit) const {
+            const GenericNode* current = root;
+            while (current != nullptr && current->left != nullptr) {
+                current = current->left;
+            }
+            while (current != nullptr) {
+                visit(current->data);
+                if (current->right != nullptr) {
+                    current = current->right;
+                    while (current->left != nullptr) {
+                        current = current->left;
+                    }
+                } else {
+                    // Subir hasta llegar desde un hijo izquierdo
+                    const GenericNode* child = current;
+                    current = current->parent;
+                    while (current != nullptr && current->right == child) {
+                        child = current;
+                        current = current->parent;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Devuelve los bytes ocupados por los nodos vivos.
+         */
+        size_t memoryUsage() const {
+            return size * sizeof(GenericNode);
+        }
+
+        /**
+         * @brief Devuelve el tamaño del árbol y sus nodos en preorden.
+         *
+         * @require `Key` debe poder escribirse en un `std::ostream`.
+         */
+        std::string toString() const {
+            std::ostringstream stream;
+            stream << "Size: " << size << "\n";
+            stream << "Elements:\n";
+            toString(root, stream);
+            return stream.str();
+        }
+};
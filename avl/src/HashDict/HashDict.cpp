@@ -0,0 +1,183 @@
+#include "HashDict.hpp"
+#include <algorithm>
+#include <sstream>
+#include "../Dict/Hash.hpp"
+#include "../Serialization/BufferedWriter.hpp"
+#include "../Simd/ByteMatch.hpp"
+
+HashDict::HashDict()
+    : migrated(0) {
+    current.control.assign(MIN_CAPACITY, int8_t(EMPTY));
+    current.keys.assign(MIN_CAPACITY, 0);
+}
+
+size_t HashDict::find(const Table& table, int key, uint64_t hashed) {
+    const size_t capacity = table.capacity();
+    if (capacity == 0) {
+        return capacity;
+    }
+
+    // Los 7 bits bajos son la etiqueta; los demás eligen el primer grupo
+    const size_t mask = capacity / simd::GROUP_BYTES - 1;
+    const int8_t tag = static_cast<int8_t>(hashed & 0x7F);
+    size_t group = (hashed >> 7) & mask;
+    for (size_t step = 1; step <= mask + 1; ++step) {
+        const int8_t* control = table.control.data() + group * simd::GROUP_BYTES;
+        for (uint32_t match = simd::matchByte(control, tag); match != 0; match &= match - 1) {
+            size_t slot = group * simd::GROUP_BYTES + simd::lowestBit(match);
+            if (table.keys[slot] == key) {
+                return slot;
+            }
+        }
+        // Un grupo con un lugar vacío termina el recorrido: la llave habría quedado ahí
+        if (simd::matchByte(control, EMPTY) != 0) {
+            return capacity;
+        }
+        group = (group + step) & mask;
+    }
+    return capacity;
+}
+
+void HashDict::place(Table& table, int key, uint64_t hashed) {
+    const size_t mask = table.capacity() / simd::GROUP_BYTES - 1;
+    size_t group = (hashed >> 7) & mask;
+    for (size_t step = 1; ; ++step) {
+        int8_t* control = table.control.data() + group * simd::GROUP_BYTES;
+        // Vacíos y lápidas son los únicos bytes de control negativos
+        uint32_t free = simd::matchNegative(control);
+        if (free != 0) {
+            size_t slot = group * simd::GROUP_BYTES + simd::lowestBit(free);
+            if (table.control[slot] == EMPTY) {
+                table.used++;
+            }
+            table.control[slot] = static_cast<int8_t>(hashed & 0x7F);
+            table.keys[slot] = key;
+            table.size++;
+            return;
+        }
+        group = (group + step) & mask;
+    }
+}
+
+void HashDict::eraseAt(Table& table, size_t slot) {
+    const int8_t* group = table.control.data() + slot / simd::GROUP_BYTES * simd::GROUP_BYTES;
+    if (simd::matchByte(group, EMPTY) != 0) {
+        // Ningún recorrido pasó de este grupo, así que el lugar puede volver a estar vacío
+        table.control[slot] = EMPTY;
+        table.used--;
+    } else {
+        table.control[slot] = DELETED;
+    }
+    table.size--;
+}
+
+void HashDict::startRehash() {
+    // Terminar cualquier migración pendiente antes de empezar otra
+    migrate(old.capacity() / simd::GROUP_BYTES);
+
+    size_t capacity = current.capacity();
+    if (current.size > capacity / 16 * 7) {
+        capacity *= 2;
+    }
+
+    old = std::move(current);
+    current = Table();
+    current.control.assign(capacity, int8_t(EMPTY));
+    current.keys.assign(capacity, 0);
+    migrated = 0;
+}
+
+void HashDict::migrate(size_t groups) {
+    if (old.capacity() == 0) {
+        return;
+    }
+
+    size_t end = std::min(migrated + groups * simd::GROUP_BYTES, old.capacity());
+    for (size_t slot = migrated; slot < end; ++slot) {
+        if (old.control[slot] >= 0) {
+            place(current, old.keys[slot], hashing::mix(old.keys[slot]));
+            // Una lápida en la vieja mantiene válidos los recorridos de las llaves que faltan
+            old.control[slot] = DELETED;
+            old.size--;
+        }
+    }
+    migrated = end;
+
+    if (migrated == old.capacity()) {
+        old = Table();
+        migrated = 0;
+    }
+}
+
+void HashDict::insert(int element) {
+    uint64_t hashed = hashing::mix(element);
+    if (find(current, element, hashed) != current.capacity()
+            || find(old, element, hashed) != old.capacity()) {
+        return; // element already exists in the table
+    }
+
+    if (current.used + 1 > current.capacity() / 8 * 7) {
+        startRehash();
+    }
+    place(current, element, hashed);
+    migrate(MIGRATE_GROUPS);
+}
+
+bool HashDict::contains(int element) {
+    uint64_t hashed = hashing::mix(element);
+    return find(current, element, hashed) != current.capacity()
+        || find(old, element, hashed) != old.capacity();
+}
+
+void HashDict::erase(int element) {
+    uint64_t hashed = hashing::mix(element);
+    size_t slot = find(current, element, hashed);
+    if (slot != current.capacity()) {
+        eraseAt(current, slot);
+    } else {
+        slot = find(old, element, hashed);
+        if (slot != old.capacity()) {
+            eraseAt(old, slot);
+        }
+    }
+    migrate(MIGRATE_GROUPS);
+}
+
+size_t HashDict::count() const {
+    return current.size + old.size;
+}
+
+bool HashDict::forEachElement(const std::function<void(int)>& visit) {
+    for (const Table* table : {&current, &old}) {
+        for (size_t slot = 0; slot < table->capacity(); ++slot) {
+            if (table->control[slot] >= 0) {
+                visit(table->keys[slot]);
+            }
+        }
+    }
+    return true;
+}
+
+std::string HashDict::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writer.write("Size: ");
+        writer.write(static_cast<int>(count()));
+        writer.write("\nElements:\n");
+        for (const Table* table : {&current, &old}) {
+            for (size_t slot = 0; slot < table->capacity(); ++slot) {
+                if (table->control[slot] >= 0) {
+                    writer.write(table->keys[slot]);
+                    writer.write(" ");
+                }
+            }
+        }
+        writer.write("\n");
+    }
+    return stream.str();
+}
+
+size_t HashDict::memoryUsage() {
+    return (current.capacity() + old.capacity()) * (sizeof(int) + sizeof(int8_t));
+}
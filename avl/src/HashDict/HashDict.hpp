@@ -0,0 +1,133 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "../Dict/Dict.h"
+
+/**
+ * @class HashDict
+ * @brief An unordered dictionary: an open-addressing hash table in the SwissTable style.
+ *
+ * Every slot has a control byte: `EMPTY`, `DELETED`, or the low 7 bits of the hash of its
+ * key. The high bits choose a group of 16 slots, and a lookup compares the 16 control
+ * bytes of the group against the 7-bit tag with one SSE2 instruction (see
+ * `simd::matchByte`), so it only reads the keys whose tag matches. Groups are probed in
+ * triangular order until one has an empty slot.
+ *
+ * Erasing leaves a `DELETED` tombstone only when the group is full; a group that still
+ * has an empty slot never stopped a probe, so the slot can go back to `EMPTY`.
+ *
+ * Growing does not move every key at once. When the table reaches 7/8 of its slots, a
+ * new table is allocated and the old one is kept; every later operation moves a few
+ * groups over until the old table is empty. Lookups check both tables meanwhile, so no
+ * single insert pays for the whole rehash.
+ */
+class HashDict : public Dict {
+    protected:
+        /// Control byte of a slot that was never used.
+        static const int8_t EMPTY = -128;
+        /// Control byte of a slot whose key was erased.
+        static const int8_t DELETED = -2;
+        /// Slots in the smallest table.
+        static const size_t MIN_CAPACITY = 16;
+        /// Groups of the old table moved by each operation while a rehash is in progress.
+        static const size_t MIGRATE_GROUPS = 2;
+
+        /**
+         * @struct Table
+         * @brief One array of slots with its control bytes.
+         */
+        struct Table {
+            std::vector<int8_t> control;  /// One control byte per slot.
+            std::vector<int> keys;        /// The key of each full slot.
+            size_t size = 0;              /// Full slots.
+            size_t used = 0;              /// Full and deleted slots.
+
+            size_t capacity() const {
+                return keys.size();
+            };
+        };
+
+        Table current;    /// The table that receives the insertions.
+        Table old;        /// The table being emptied by an incremental rehash, or empty.
+        size_t migrated;  /// Slots of `old` already moved to `current`.
+
+        /**
+         * @brief Devuelve la posición de `key` en `table`, o `capacity()` si no está.
+         */
+        static size_t find(const Table& table, int key, uint64_t hashed);
+
+        /**
+         * @brief Ubica una llave que no está en `table` en el primer lugar libre de su recorrido.
+         */
+        static void place(Table& table, int key, uint64_t hashed);
+
+        /**
+         * @brief Vacía el lugar `slot` de `table`, dejando una lápida si el grupo está lleno.
+         */
+        static void eraseAt(Table& table, size_t slot);
+
+        /**
+         * @brief Crea la tabla nueva y deja la actual como la vieja que se irá vaciando.
+         *
+         * @effect Si la mayoría de los lugares usados son lápidas, la tabla nueva tiene la
+         *         misma capacidad; si no, el doble.
+         */
+        void startRehash();
+
+        /**
+         * @brief Mueve hasta `groups` grupos de la tabla vieja a la nueva.
+         */
+        void migrate(size_t groups);
+
+    public:
+        /**
+         * @brief Constructs an empty table with the minimum capacity.
+         */
+        HashDict();
+
+        /**
+         * @brief Inserta un elemento si no estaba.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en la tabla.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en la tabla, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento si está presente.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Devuelve la cantidad de llaves.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Llama a `visit` con cada llave de ambas tablas, en el orden de sus lugares.
+         *
+         * @return true, porque la tabla siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño y las llaves en el orden de sus lugares.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes de las llaves y de los bytes de control de ambas tablas.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,175 @@
+#include "LearnedDict.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+#include "../AVLTree/AVLTree.hpp"
+#include "../Dict/Batch.hpp"
+#include "../Serialization/BufferedWriter.hpp"
+
+LearnedDict::LearnedDict(const int* sorted, size_t count)
+    : root{0, 0, 0, 0} {
+    for (size_t i = 1; i < count; ++i) {
+        if (sorted[i - 1] >= sorted[i]) {
+            keys = batch::sortedUnique(sorted, count);
+            break;
+        }
+    }
+    if (keys.empty()) {
+        keys.assign(sorted, sorted + count);
+    }
+    train();
+}
+
+LearnedDict::LearnedDict(const AVLTree& tree)
+    : root{0, 0, 0, 0} {
+    for (int key : tree) {
+        keys.push_back(key);
+    }
+    train();
+}
+
+LearnedDict::Model LearnedDict::fitLine(const int* keys, size_t count, double first,
+        double step) {
+    Model line{0, first, 0, 0};
+    if (count < 2) {
+        return line;
+    }
+
+    // Centrar antes de acumular evita perder precisión con millones de llaves grandes
+    double meanKey = 0;
+    for (size_t i = 0; i < count; ++i) {
+        meanKey += keys[i];
+    }
+    meanKey /= count;
+    const double meanPosition = first + step * (count - 1) / 2;
+
+    double covariance = 0;
+    double variance = 0;
+    for (size_t i = 0; i < count; ++i) {
+        const double key = keys[i] - meanKey;
+        covariance += key * (first + step * i - meanPosition);
+        variance += key * key;
+    }
+    if (variance > 0) {
+        line.slope = covariance / variance;
+    }
+    line.intercept = meanPosition - line.slope * meanKey;
+    return line;
+}
+
+long long LearnedDict::predict(const Model& model, int key) {
+    return static_cast<long long>(model.slope * key + model.intercept);
+}
+
+size_t LearnedDict::modelFor(int key) const {
+    long long model = predict(root, key);
+    if (model < 0) {
+        return 0;
+    }
+    return std::min(static_cast<size_t>(model), models.size() - 1);
+}
+
+void LearnedDict::train() {
+    const size_t modelCount = std::max<size_t>(1, keys.size() / KEYS_PER_MODEL);
+    root = fitLine(keys.data(), keys.size(), 0,
+        keys.empty() ? 0 : static_cast<double>(modelCount) / keys.size());
+    models.assign(modelCount, Model{0, 0, 0, 0});
+
+    // La primera etapa no decrece, así que cada modelo recibe un tramo contiguo
+    size_t begin = 0;
+    for (size_t model = 0; model < modelCount; ++model) {
+        size_t end = begin;
+        while (end < keys.size() && modelFor(keys[end]) == model) {
+            end++;
+        }
+
+        Model& line = models[model];
+        line = fitLine(keys.data() + begin, end - begin, static_cast<double>(begin), 1);
+        if (begin < end) {
+            long long low = 0;
+            long long high = 0;
+            for (size_t i = begin; i < end; ++i) {
+                long long error = static_cast<long long>(i) - predict(line, keys[i]);
+                low = i == begin ? error : std::min(low, error);
+                high = i == begin ? error : std::max(high, error);
+            }
+            // Un lugar de más a cada lado cubre redondeos distintos entre compilaciones
+            line.errorLow = static_cast<int>(low) - 1;
+            line.errorHigh = static_cast<int>(high) + 1;
+        }
+        begin = end;
+    }
+}
+
+void LearnedDict::insert(int) {
+    throw std::logic_error("LearnedDict: the dictionary is immutable");
+}
+
+bool LearnedDict::contains(int element) {
+    if (keys.empty()) {
+        return false;
+    }
+    const Model& line = models[modelFor(element)];
+    const long long position = predict(line, element);
+    const long long size = static_cast<long long>(keys.size());
+    const long long low = std::max(0LL, std::min(size, position + line.errorLow));
+    const long long high = std::max(low, std::min(size, position + line.errorHigh + 1));
+
+    const int* found = std::lower_bound(keys.data() + low, keys.data() + high, element);
+    return found != keys.data() + high && *found == element;
+}
+
+void LearnedDict::erase(int) {
+    throw std::logic_error("LearnedDict: the dictionary is immutable");
+}
+
+void LearnedDict::insertMany(const int*, size_t) {
+    throw std::logic_error("LearnedDict: the dictionary is immutable");
+}
+
+void LearnedDict::eraseMany(const int*, size_t) {
+    throw std::logic_error("LearnedDict: the dictionary is immutable");
+}
+
+bool LearnedDict::forEachElement(const std::function<void(int)>& visit) {
+    for (int key : keys) {
+        visit(key);
+    }
+    return true;
+}
+
+size_t LearnedDict::count() const {
+    return keys.size();
+}
+
+int LearnedDict::maxSearchWidth() const {
+    int width = 0;
+    for (const Model& line : models) {
+        width = std::max(width, line.errorHigh - line.errorLow + 1);
+    }
+    return width;
+}
+
+std::string LearnedDict::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writer.write("Size: ");
+        writer.write(static_cast<int>(keys.size()));
+        writer.write("\nModels: ");
+        writer.write(static_cast<int>(models.size()));
+        writer.write(", max search width: ");
+        writer.write(maxSearchWidth());
+        writer.write("\nElements:\n");
+        for (int key : keys) {
+            writer.write(key);
+            writer.write(" ");
+        }
+        writer.write("\n");
+    }
+    return stream.str();
+}
+
+size_t LearnedDict::memoryUsage() {
+    return keys.capacity() * sizeof(int) + models.capacity() * sizeof(Model);
+}
@@ -0,0 +1,144 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../Dict/Dict.h"
+
+class AVLTree;
+
+/**
+ * @class LearnedDict
+ * @brief An immutable dictionary that predicts where a key is instead of searching for it,
+ *        with a two-stage recursive model index (Kraska et al.).
+ *
+ * The keys are stored in one ascending array. A key's position is its rank, so the
+ * array is a function from keys to positions that a model can learn. The first stage is
+ * one line fitted to the whole array that picks one of the second-stage models; each of
+ * those is a line fitted by least squares to the keys the first stage sends to it. The
+ * first stage never decreases, so every second-stage model covers a contiguous run of the
+ * array.
+ *
+ * Each second-stage model remembers how far its predictions fell below and above the true
+ * positions of its keys. A search evaluates two lines and finishes with a binary search
+ * between those bounds, a few keys instead of log n: a present key is always inside them,
+ * and a missing key is reported as soon as they hold no equal key.
+ *
+ * It is built from any ascending array or from an `AVLTree`. `insert` and `erase` throw
+ * `std::logic_error`.
+ */
+class LearnedDict : public Dict {
+    private:
+        /// Keys per second-stage model on average.
+        static const size_t KEYS_PER_MODEL = 32;
+
+        /**
+         * @struct Model
+         * @brief A line that predicts a position, and the errors of its predictions.
+         */
+        struct Model {
+            double slope;
+            double intercept;
+            int errorLow;   /// Lowest `position - prediction` among its keys, or 0.
+            int errorHigh;  /// Highest `position - prediction` among its keys, or 0.
+        };
+
+        std::vector<int> keys;     /// All the keys, ascending.
+        Model root;                /// First stage: predicts the second-stage model.
+        std::vector<Model> models; /// Second stage: predict the position of the key.
+
+        /**
+         * @brief Ajusta por mínimos cuadrados la recta que lleva `keys[i]` a `first + step * i`.
+         *
+         * @return La recta, con pendiente 0 si las llaves no alcanzan para definirla.
+         */
+        static Model fitLine(const int* keys, size_t count, double first, double step);
+
+        /**
+         * @brief Evalúa la recta de un modelo en `key`, truncando hacia cero.
+         */
+        static long long predict(const Model& model, int key);
+
+        /**
+         * @brief Devuelve el modelo de la segunda etapa que corresponde a `key`.
+         */
+        size_t modelFor(int key) const;
+
+        /**
+         * @brief Ajusta las dos etapas a `keys` y mide los errores de cada modelo.
+         */
+        void train();
+
+    public:
+        /**
+         * @brief Builds the dictionary from `count` keys.
+         *
+         * @param sorted The keys; if they are not strictly ascending a sorted copy without
+         *        repeated keys is used instead.
+         * @param count The number of keys.
+         */
+        LearnedDict(const int* sorted, size_t count);
+
+        /**
+         * @brief Builds the dictionary from the keys of `tree`, walking it in order once.
+         */
+        explicit LearnedDict(const AVLTree& tree);
+
+        LearnedDict(const LearnedDict&) = delete;
+        LearnedDict& operator=(const LearnedDict&) = delete;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente evaluando los dos modelos y buscando
+         *        solo entre las cotas de error del segundo.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el diccionario, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Siempre lanza `std::logic_error`: el diccionario es inmutable.
+         */
+        void eraseMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Llama a `visit` con cada llave en orden ascendente.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve la cantidad de llaves.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Devuelve el ancho de la búsqueda más larga: la mayor diferencia entre las
+         *        cotas de error de un modelo.
+         */
+        int maxSearchWidth() const;
+
+        /**
+         * @brief Devuelve el tamaño, los modelos, el ancho de búsqueda máximo y las llaves en orden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes de las llaves y de los modelos.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,50 @@
+#include "LockedDict.hpp"
+
+LockedDict::LockedDict(Dict& dict)
+    : dict(dict) {
+}
+
+void LockedDict::insert(int element) {
+    std::lock_guard<std::mutex> lock(mutex);
+    dict.insert(element);
+}
+
+bool LockedDict::contains(int element) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dict.contains(element);
+}
+
+void LockedDict::erase(int element) {
+    std::lock_guard<std::mutex> lock(mutex);
+    dict.erase(element);
+}
+
+void LockedDict::insertMany(const int* elements, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    dict.insertMany(elements, count);
+}
+
+void LockedDict::containsMany(const int* elements, size_t count, std::vector<bool>& found) {
+    std::lock_guard<std::mutex> lock(mutex);
+    dict.containsMany(elements, count, found);
+}
+
+void LockedDict::eraseMany(const int* elements, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    dict.eraseMany(elements, count);
+}
+
+bool LockedDict::forEachElement(const std::function<void(int)>& visit) {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dict.forEachElement(visit);
+}
+
+std::string LockedDict::toString() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dict.toString();
+}
+
+size_t LockedDict::memoryUsage() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dict.memoryUsage();
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <mutex>
+#include <string>
+#include "../Dict/Dict.h"
+
+/**
+ * @class LockedDict
+ * @brief Makes any dictionary thread-safe by running every operation under one mutex.
+ *
+ * This is the coarse-grained baseline that `ConcurrentAVLTree` is measured against:
+ * it is always correct, but only one thread at a time can use the dictionary.
+ */
+class LockedDict : public Dict {
+    private:
+        Dict& dict;        /// The wrapped dictionary, owned by the caller.
+        std::mutex mutex;  /// Serializes every operation on `dict`.
+
+    public:
+        /**
+         * @brief Wraps `dict`, which must outlive the wrapper.
+         */
+        explicit LockedDict(Dict& dict);
+
+        /**
+         * @brief Inserta un elemento con el mutex tomado.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente con el mutex tomado.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento con el mutex tomado.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Inserta un lote completo con el mutex tomado una sola vez.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Verifica un lote completo con el mutex tomado una sola vez.
+         */
+        void containsMany(const int* elements, size_t count, std::vector<bool>& found) override;
+
+        /**
+         * @brief Elimina un lote completo con el mutex tomado una sola vez.
+         */
+        void eraseMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Recorre las llaves del diccionario envuelto con el mutex tomado.
+         *
+         * @return false si el diccionario envuelto no puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve la representación del diccionario envuelto.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve la memoria del diccionario envuelto.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,287 @@
+#include "LsmDict.hpp"
+#include <algorithm>
+#include <sstream>
+#include "../Serialization/BufferedWriter.hpp"
+
+LsmDict::LsmDict()
+    : memtable(AVLTree::ARENA_NODES)
+    , tombstones(AVLTree::ARENA_NODES)
+    , memtableWrites(0)
+    , runs(std::make_shared<const RunList>())
+    , stopping(false)
+    , compactions(0)
+    , lookups(0)
+    , structuresProbed(0) {
+    // El worker arranca cuando todos los miembros ya están inicializados
+    worker = std::thread(&LsmDict::compactLoop, this);
+}
+
+LsmDict::~LsmDict() {
+    {
+        std::lock_guard<std::mutex> lock(runsLock);
+        stopping = true;
+    }
+    compactionWanted.notify_all();
+    worker.join();
+}
+
+std::shared_ptr<const LsmDict::RunList> LsmDict::currentRuns() {
+    std::lock_guard<std::mutex> lock(runsLock);
+    return runs;
+}
+
+LsmDict::Run LsmDict::memtableRun() const {
+    // Una llave nunca está en los dos árboles: insert y erase la quitan del otro
+    Run run;
+    AVLTree::Iterator key = memtable.begin();
+    AVLTree::Iterator erased = tombstones.begin();
+    while (key != memtable.end() || erased != tombstones.end()) {
+        if (erased == tombstones.end() || (key != memtable.end() && *key < *erased)) {
+            run.push_back(Entry{*key, false});
+            ++key;
+        } else {
+            run.push_back(Entry{*erased, true});
+            ++erased;
+        }
+    }
+    return run;
+}
+
+void LsmDict::flush() {
+    Run run = memtableRun();
+    memtable.clear();
+    tombstones.clear();
+    memtableWrites = 0;
+    if (run.empty()) {
+        return;
+    }
+
+    std::shared_ptr<const Run> published = std::make_shared<const Run>(std::move(run));
+    std::unique_lock<std::mutex> lock(runsLock);
+    compactionDone.wait(lock, [this] {
+        return runs->size() < static_cast<size_t>(STALL_RUNS);
+    });
+    std::shared_ptr<RunList> next = std::make_shared<RunList>();
+    next->reserve(runs->size() + 1);
+    next->push_back(published);
+    next->insert(next->end(), runs->begin(), runs->end());
+    runs = next;
+    compactionWanted.notify_one();
+}
+
+int LsmDict::tier(size_t entries) {
+    int level = 0;
+    for (size_t limit = MEMTABLE_WRITES; entries > limit; limit *= FANOUT) {
+        level++;
+    }
+    return level;
+}
+
+int LsmDict::pickCompaction(const RunList& list) {
+    const int count = static_cast<int>(list.size());
+    for (int first = 0; first + FANOUT <= count; ++first) {
+        const int level = tier(list[first]->size());
+        int last = first + 1;
+        while (last < first + FANOUT && tier(list[last]->size()) == level) {
+            last++;
+        }
+        if (last == first + FANOUT) {
+            return first;
+        }
+    }
+
+    // Los niveles pueden quedar intercalados cuando una mezcla cancela muchas llaves;
+    // antes de frenar las escrituras se mezclan los runs más nuevos aunque no coincidan
+    if (count >= STALL_RUNS / 2) {
+        return 0;
+    }
+    return -1;
+}
+
+LsmDict::Run LsmDict::mergeRuns(const std::shared_ptr<const Run>* newest, size_t count,
+        bool dropTombstones) {
+    std::vector<size_t> positions(count, 0);
+    size_t total = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total += newest[i]->size();
+    }
+    Run merged;
+    merged.reserve(total);
+
+    while (true) {
+        // En un empate gana el primero encontrado, que es el run más nuevo
+        int smallest = -1;
+        for (size_t i = 0; i < count; ++i) {
+            if (positions[i] < newest[i]->size() && (smallest < 0
+                    || (*newest[i])[positions[i]].key < (*newest[smallest])[positions[smallest]].key)) {
+                smallest = static_cast<int>(i);
+            }
+        }
+        if (smallest < 0) {
+            break;
+        }
+
+        const Entry entry = (*newest[smallest])[positions[smallest]];
+        for (size_t i = 0; i < count; ++i) {
+            if (positions[i] < newest[i]->size() && (*newest[i])[positions[i]].key == entry.key) {
+                positions[i]++;
+            }
+        }
+        if (!dropTombstones || !entry.tombstone) {
+            merged.push_back(entry);
+        }
+    }
+    return merged;
+}
+
+const LsmDict::Entry* LsmDict::find(const Run& run, int key) {
+    Run::const_iterator entry = std::lower_bound(run.begin(), run.end(), key,
+        [](const Entry& current, int target) {
+            return current.key < target;
+        });
+    if (entry == run.end() || entry->key != key) {
+        return nullptr;
+    }
+    return &*entry;
+}
+
+void LsmDict::compactLoop() {
+    std::unique_lock<std::mutex> lock(runsLock);
+    while (true) {
+        compactionWanted.wait(lock, [this] {
+            return stopping || pickCompaction(*runs) >= 0;
+        });
+        if (stopping) {
+            return;
+        }
+
+        // La mezcla trabaja sobre una copia de la lista, sin el mutex tomado
+        std::shared_ptr<const RunList> snapshot = runs;
+        const int first = pickCompaction(*snapshot);
+        const bool reachesOldest = first + FANOUT == static_cast<int>(snapshot->size());
+        lock.unlock();
+        std::shared_ptr<const Run> merged = std::make_shared<const Run>(
+            mergeRuns(snapshot->data() + first, FANOUT, reachesOldest));
+        lock.lock();
+
+        // Mientras tanto solo pudieron agregarse runs nuevos al principio de la lista
+        const size_t offset = runs->size() - snapshot->size();
+        std::shared_ptr<RunList> next = std::make_shared<RunList>(*runs);
+        RunList::iterator window = next->begin() + offset + first;
+        window = next->erase(window, window + FANOUT);
+        if (!merged->empty()) {
+            next->insert(window, merged);
+        }
+        runs = next;
+        compactions++;
+        compactionDone.notify_all();
+    }
+}
+
+void LsmDict::insert(int element) {
+    tombstones.erase(element);
+    memtable.insert(element);
+    if (++memtableWrites >= MEMTABLE_WRITES) {
+        flush();
+    }
+}
+
+bool LsmDict::contains(int element) {
+    lookups++;
+    structuresProbed++;
+    if (memtable.contains(element)) {
+        return true;
+    }
+    if (tombstones.contains(element)) {
+        return false;
+    }
+
+    std::shared_ptr<const RunList> list = currentRuns();
+    for (const std::shared_ptr<const Run>& run : *list) {
+        structuresProbed++;
+        const Entry* entry = find(*run, element);
+        if (entry != nullptr) {
+            return !entry->tombstone;
+        }
+    }
+    return false;
+}
+
+void LsmDict::erase(int element) {
+    memtable.erase(element);
+    tombstones.insert(element);
+    if (++memtableWrites >= MEMTABLE_WRITES) {
+        flush();
+    }
+}
+
+size_t LsmDict::runCount() {
+    return currentRuns()->size();
+}
+
+size_t LsmDict::compactionCount() {
+    std::lock_guard<std::mutex> lock(runsLock);
+    return compactions;
+}
+
+double LsmDict::readAmplification() const {
+    return lookups == 0 ? 0 : static_cast<double>(structuresProbed) / lookups;
+}
+
+void LsmDict::resetStatistics() {
+    lookups = 0;
+    structuresProbed = 0;
+}
+
+LsmDict::Run LsmDict::visibleRun(const RunList& list) const {
+    RunList all;
+    all.push_back(std::make_shared<const Run>(memtableRun()));
+    all.insert(all.end(), list.begin(), list.end());
+    return mergeRuns(all.data(), all.size(), true);
+}
+
+bool LsmDict::forEachElement(const std::function<void(int)>& visit) {
+    for (const Entry& entry : visibleRun(*currentRuns())) {
+        visit(entry.key);
+    }
+    return true;
+}
+
+std::string LsmDict::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer);
+    }
+    return stream.str();
+}
+
+void LsmDict::writeTo(BufferedWriter& writer) {
+    std::shared_ptr<const RunList> list = currentRuns();
+    Run visible = visibleRun(*list);
+
+    writer.write("Memtable writes: ");
+    writer.write(memtableWrites);
+    writer.write("\nRuns:");
+    for (const std::shared_ptr<const Run>& run : *list) {
+        writer.write(" ");
+        writer.write(static_cast<int>(run->size()));
+    }
+    writer.write("\nElements:\n");
+    for (size_t i = 0; i < visible.size(); ++i) {
+        if (i > 0) {
+            writer.write(" ");
+        }
+        writer.write(visible[i].key);
+    }
+    writer.write("\n");
+}
+
+size_t LsmDict::memoryUsage() {
+    size_t bytes = memtable.memoryUsage() + tombstones.memoryUsage();
+    std::shared_ptr<const RunList> list = currentRuns();
+    for (const std::shared_ptr<const Run>& run : *list) {
+        bytes += run->capacity() * sizeof(Entry);
+    }
+    return bytes;
+}
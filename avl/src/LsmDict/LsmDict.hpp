@@ -0,0 +1,223 @@
+#pragma once
+#include <condition_variable>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "../Dict/Dict.h"
+#include "../AVLTree/AVLTree.hpp"
+
+class BufferedWriter;
+
+/**
+ * @class LsmDict
+ * @brief A write-optimized dictionary in the style of a log-structured merge tree.
+ *
+ * Writes go to a small in-memory table (the memtable): an `AVLTree` with the inserted
+ * keys and another with the erased ones (tombstones), both backed by a `NodeArena` so a
+ * write does not reach the heap. After `MEMTABLE_WRITES` writes the memtable is flushed
+ * to an immutable sorted array, a run, and emptied in one step.
+ *
+ * A search looks in the memtable first and then in the runs from the newest to the
+ * oldest; the first entry found for the key, a key or a tombstone, decides. Every run
+ * probed is one more binary search, the read amplification that is traded for cheap
+ * writes.
+ *
+ * A worker thread keeps the number of runs low. Runs belong to a tier by their size, and
+ * when `FANOUT` consecutive runs share a tier the worker merges them into one run of the
+ * next tier, without blocking readers or the flushing thread: the run list is an
+ * immutable, reference-counted snapshot that is replaced under a mutex. Tombstones are
+ * dropped only when the merge reaches the oldest run, since nothing older can hide
+ * behind them. If the runs pile up to `STALL_RUNS` anyway, a flush waits for the worker.
+ *
+ * `insert`, `contains` and `erase` must be called from one thread at a time; the worker
+ * is the only other thread.
+ */
+class LsmDict : public Dict {
+    protected:
+        /// Writes buffered in the memtable before it is flushed to a run.
+        static const int MEMTABLE_WRITES = 4096;
+        /// Runs of the same tier merged at once; also the size ratio between tiers.
+        static const int FANOUT = 4;
+        /// Runs at which a flush waits for a compaction to finish.
+        static const int STALL_RUNS = 32;
+
+        /**
+         * @struct Entry
+         * @brief A key in a run, either present or erased.
+         */
+        struct Entry {
+            int key;
+            bool tombstone;
+        };
+
+        /// A run: entries sorted by key, one per key, never modified once published.
+        typedef std::vector<Entry> Run;
+        /// The runs from the newest to the oldest.
+        typedef std::vector<std::shared_ptr<const Run>> RunList;
+
+        AVLTree memtable;   /// Keys inserted since the last flush.
+        AVLTree tombstones; /// Keys erased since the last flush.
+        int memtableWrites; /// Writes since the last flush.
+
+        std::shared_ptr<const RunList> runs;  /// Current runs; replaced, never modified.
+        std::mutex runsLock;                  /// Guards `runs`, `stopping` and `compactions`.
+        std::condition_variable compactionWanted; /// Wakes the worker after a flush.
+        std::condition_variable compactionDone;   /// Wakes a stalled flush.
+        bool stopping;                        /// Tells the worker to finish.
+        size_t compactions;                   /// Merges done by the worker.
+        std::thread worker;                   /// Merges runs in the background.
+
+        size_t lookups;          /// Calls to `contains` since the last reset.
+        size_t structuresProbed; /// Memtables and runs searched by those calls.
+
+        /**
+         * @brief Devuelve la lista de runs actual, que sigue válida aunque el worker la reemplace.
+         */
+        std::shared_ptr<const RunList> currentRuns();
+
+        /**
+         * @brief Devuelve el memtable como un run: sus llaves y sus tombstones en orden.
+         */
+        Run memtableRun() const;
+
+        /**
+         * @brief Convierte el memtable en el run más nuevo y lo vacía.
+         *
+         * @effect Si ya hay `STALL_RUNS` runs, espera a que el worker termine una compactación.
+         */
+        void flush();
+
+        /**
+         * @brief Devuelve el nivel de un run según su tamaño: 0 hasta `MEMTABLE_WRITES`
+         *        entradas, y uno más por cada factor `FANOUT`.
+         */
+        static int tier(size_t entries);
+
+        /**
+         * @brief Elige `FANOUT` runs consecutivos para compactar.
+         *
+         * @return La posición del más nuevo, o -1 si no hace falta compactar.
+         */
+        static int pickCompaction(const RunList& list);
+
+        /**
+         * @brief Mezcla `count` runs consecutivos, del más nuevo al más viejo, en uno solo.
+         *
+         * @effect Para cada llave se queda con la entrada del run más nuevo.
+         *
+         * @param dropTombstones Si se descartan los tombstones, lo que solo es válido si no
+         *        hay runs más viejos que los mezclados.
+         */
+        static Run mergeRuns(const std::shared_ptr<const Run>* newest, size_t count,
+                bool dropTombstones);
+
+        /**
+         * @brief Busca la entrada de una llave en un run.
+         *
+         * @return La entrada, o nullptr si el run no tiene la llave.
+         */
+        static const Entry* find(const Run& run, int key);
+
+        /**
+         * @brief Mezcla el memtable con `list` y devuelve solo las llaves visibles, en orden.
+         */
+        Run visibleRun(const RunList& list) const;
+
+        /**
+         * @brief Compacta runs mientras haga falta, hasta que se pida terminar.
+         */
+        void compactLoop();
+
+        /**
+         * @brief Escribe los runs, sus tamaños y las llaves visibles en orden.
+         */
+        void writeTo(BufferedWriter& writer);
+
+    public:
+        /**
+         * @brief Constructs an empty dictionary and starts its compaction worker.
+         */
+        LsmDict();
+
+        LsmDict(const LsmDict&) = delete;
+        LsmDict& operator=(const LsmDict&) = delete;
+
+        /**
+         * @brief Stops the worker, letting it finish the merge in progress, and frees every run.
+         */
+        ~LsmDict();
+
+        /**
+         * @brief Inserta un elemento en el memtable, quitando su tombstone si lo tenía.
+         *
+         * @effect Si el memtable llegó a `MEMTABLE_WRITES` escrituras, lo convierte en un run.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente.
+         *
+         * @effect Busca en el memtable y luego en los runs del más nuevo al más viejo,
+         *         hasta la primera entrada de la llave.
+         *
+         * @param element El valor a buscar.
+         * @return true si la entrada más nueva del elemento no es un tombstone.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento escribiendo un tombstone en el memtable.
+         *
+         * @effect No busca el elemento en los runs: el tombstone lo oculta hasta que una
+         *         compactación que llegue al run más viejo descarte ambos.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Devuelve la cantidad de runs actual.
+         */
+        size_t runCount();
+
+        /**
+         * @brief Devuelve las compactaciones hechas por el worker.
+         */
+        size_t compactionCount();
+
+        /**
+         * @brief Devuelve las estructuras, memtable y runs, buscadas en promedio por cada
+         *        `contains` desde el último `resetStatistics`.
+         */
+        double readAmplification() const;
+
+        /**
+         * @brief Pone en cero los contadores de `readAmplification`.
+         */
+        void resetStatistics();
+
+        /**
+         * @brief Llama a `visit` con cada llave visible en orden ascendente.
+         *
+         * @effect Mezcla el memtable con los runs actuales como lo haría una compactación
+         *         completa, sin publicar el resultado.
+         *
+         * @return true, porque el diccionario siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve la cantidad de runs y sus tamaños, y las llaves visibles en orden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes del memtable y de los runs.
+         */
+        size_t memoryUsage() override;
+};
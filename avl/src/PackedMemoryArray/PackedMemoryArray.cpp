@@ -0,0 +1,304 @@
+#include "PackedMemoryArray.hpp"
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <sstream>
+#include "../Dict/Batch.hpp"
+#include "../Serialization/BufferedWriter.hpp"
+#include "../Simd/KeySearch.hpp"
+
+PackedMemoryArray::PackedMemoryArray()
+    : segmentSize(0)
+    , segmentCount(0)
+    , size(0) {
+    rebuildFromScratch();
+}
+
+size_t PackedMemoryArray::capacity() const {
+    return segmentSize * segmentCount;
+}
+
+int PackedMemoryArray::indexKey(size_t segment) const {
+    return index[segment / INDEX_KEYS].keys[segment % INDEX_KEYS];
+}
+
+size_t PackedMemoryArray::findSegment(int key) const {
+    // El primer segmento vacío guarda INT_MIN, así que solo se cae antes del bloque 0 si
+    // `key` es menor que todas las llaves, y entonces su lugar es el segmento 0
+    size_t block = std::upper_bound(blockKeys.begin(), blockKeys.end(), key) - blockKeys.begin();
+    if (block == 0) {
+        return 0;
+    }
+    block--;
+
+    // El relleno de INT_MAX también cuenta cuando `key` es INT_MAX
+    size_t segment = block * INDEX_KEYS
+        + simd::countNotGreater<INDEX_KEYS>(index[block].keys, key) - 1;
+    segment = std::min(segment, segmentCount - 1);
+    // Solo el arreglo mínimo puede tener segmentos vacíos, así que esto da pocos pasos
+    while (segment > 0 && counts[segment] == 0) {
+        segment--;
+    }
+    return segment;
+}
+
+size_t PackedMemoryArray::lowerBound(size_t segment, int key) const {
+    const int* keys = slots.data() + segment * segmentSize;
+    return std::lower_bound(keys, keys + counts[segment], key) - keys;
+}
+
+void PackedMemoryArray::refreshIndex(size_t first, size_t last) {
+    size_t segment = first;
+    for (; segment < segmentCount && (segment < last || counts[segment] == 0); ++segment) {
+        int key;
+        if (counts[segment] > 0) {
+            key = slots[segment * segmentSize];
+        } else {
+            key = segment > 0 ? indexKey(segment - 1) : INT_MIN;
+        }
+        index[segment / INDEX_KEYS].keys[segment % INDEX_KEYS] = key;
+    }
+
+    for (size_t block = first / INDEX_KEYS; block * INDEX_KEYS < segment; ++block) {
+        blockKeys[block] = index[block].keys[0];
+    }
+}
+
+void PackedMemoryArray::spread(size_t first, size_t last) {
+    const size_t windowSegments = last - first;
+    const size_t share = scratch.size() / windowSegments;
+    const size_t extra = scratch.size() % windowSegments;
+
+    const int* next = scratch.data();
+    for (size_t segment = first; segment < last; ++segment) {
+        const size_t keys = share + (segment - first < extra ? 1 : 0);
+        std::copy(next, next + keys, slots.begin() + segment * segmentSize);
+        counts[segment] = static_cast<int>(keys);
+        next += keys;
+    }
+    refreshIndex(first, last);
+}
+
+void PackedMemoryArray::gather(size_t first, size_t last) {
+    for (size_t segment = first; segment < last; ++segment) {
+        const int* keys = slots.data() + segment * segmentSize;
+        scratch.insert(scratch.end(), keys, keys + counts[segment]);
+    }
+}
+
+void PackedMemoryArray::rebuildFromScratch() {
+    size_t slotCount = MIN_CAPACITY;
+    while (scratch.size() > slotCount / 2) {
+        slotCount *= 2;
+    }
+    size_t levels = 0;
+    while ((size_t(1) << levels) < slotCount) {
+        levels++;
+    }
+    segmentSize = MIN_SEGMENT;
+    while (segmentSize < levels) {
+        segmentSize *= 2;
+    }
+    segmentCount = slotCount / segmentSize;
+
+    slots.assign(slotCount, 0);
+    counts.assign(segmentCount, 0);
+    IndexBlock padding;
+    std::fill(padding.keys, padding.keys + INDEX_KEYS, INT_MAX);
+    index.assign((segmentCount + INDEX_KEYS - 1) / INDEX_KEYS, padding);
+    blockKeys.assign(index.size(), INT_MAX);
+
+    size = scratch.size();
+    spread(0, segmentCount);
+    scratch.clear();
+}
+
+double PackedMemoryArray::densityLimit(size_t height) const {
+    size_t levels = 0;
+    while ((size_t(1) << levels) < segmentCount) {
+        levels++;
+    }
+    if (levels == 0) {
+        return ROOT_DENSITY;
+    }
+    return LEAF_DENSITY - (LEAF_DENSITY - ROOT_DENSITY) * height / levels;
+}
+
+double PackedMemoryArray::sparsityLimit(size_t height) const {
+    size_t levels = 0;
+    while ((size_t(1) << levels) < segmentCount) {
+        levels++;
+    }
+    const double leafDensity = 1.0 / segmentSize;
+    if (levels == 0) {
+        return MIN_DENSITY;
+    }
+    return leafDensity + (MIN_DENSITY - leafDensity) * height / levels;
+}
+
+void PackedMemoryArray::refill(size_t segment) {
+    // Subir por ventanas alineadas hasta una con suficientes llaves para todos sus segmentos
+    for (size_t windowSegments = 2, height = 1; windowSegments <= segmentCount;
+            windowSegments *= 2, ++height) {
+        const size_t first = segment & ~(windowSegments - 1);
+        const size_t last = first + windowSegments;
+        size_t keysInWindow = 0;
+        for (size_t i = first; i < last; ++i) {
+            keysInWindow += counts[i];
+        }
+        if (keysInWindow >= sparsityLimit(height) * windowSegments * segmentSize) {
+            gather(first, last);
+            spread(first, last);
+            scratch.clear();
+            return;
+        }
+    }
+    // El arreglo mínimo puede tener menos llaves que segmentos: el segmento queda vacío
+    refreshIndex(segment, segment + 1);
+}
+
+void PackedMemoryArray::insert(int element) {
+    if (size + 1 > ROOT_DENSITY * capacity()) {
+        gather(0, segmentCount);
+        rebuildFromScratch();
+    }
+
+    const size_t segment = findSegment(element);
+    const size_t position = lowerBound(segment, element);
+    int* keys = slots.data() + segment * segmentSize;
+    if (position < static_cast<size_t>(counts[segment]) && keys[position] == element) {
+        return; // element already exists in the array
+    }
+
+    if (static_cast<size_t>(counts[segment]) < segmentSize) {
+        std::copy_backward(keys + position, keys + counts[segment], keys + counts[segment] + 1);
+        keys[position] = element;
+        counts[segment]++;
+        size++;
+        if (position == 0) {
+            refreshIndex(segment, segment + 1);
+        }
+        return;
+    }
+
+    // El segmento está lleno: subir por ventanas alineadas hasta una que admita la llave
+    for (size_t height = 1; ; ++height) {
+        const size_t windowSegments = size_t(1) << height;
+        const size_t first = segment & ~(windowSegments - 1);
+        const size_t last = first + windowSegments;
+        size_t keysInWindow = 0;
+        for (size_t i = first; i < last; ++i) {
+            keysInWindow += counts[i];
+        }
+        if (keysInWindow + 1 <= densityLimit(height) * windowSegments * segmentSize
+                || windowSegments >= segmentCount) {
+            gather(first, last);
+            scratch.insert(std::lower_bound(scratch.begin(), scratch.end(), element), element);
+            spread(first, last);
+            scratch.clear();
+            size++;
+            return;
+        }
+    }
+}
+
+bool PackedMemoryArray::contains(int element) {
+    const size_t segment = findSegment(element);
+    const size_t position = lowerBound(segment, element);
+    return position < static_cast<size_t>(counts[segment])
+        && slots[segment * segmentSize + position] == element;
+}
+
+void PackedMemoryArray::erase(int element) {
+    const size_t segment = findSegment(element);
+    const size_t position = lowerBound(segment, element);
+    int* keys = slots.data() + segment * segmentSize;
+    if (position >= static_cast<size_t>(counts[segment]) || keys[position] != element) {
+        return;
+    }
+
+    std::copy(keys + position + 1, keys + counts[segment], keys + position);
+    counts[segment]--;
+    size--;
+
+    if (capacity() > MIN_CAPACITY && size < MIN_DENSITY * capacity()) {
+        gather(0, segmentCount);
+        rebuildFromScratch();
+    } else if (counts[segment] == 0) {
+        refill(segment);
+    } else if (position == 0) {
+        refreshIndex(segment, segment + 1);
+    }
+}
+
+void PackedMemoryArray::insertMany(const int* elements, size_t count) {
+    std::vector<int> keys = batch::sortedUnique(elements, count);
+
+    // Con un lote chico sale más barato insertar que reconstruir todo el arreglo
+    if (keys.size() * 8 < size) {
+        for (int key : keys) {
+            insert(key);
+        }
+        return;
+    }
+
+    gather(0, segmentCount);
+    std::vector<int> merged;
+    merged.reserve(scratch.size() + keys.size());
+    std::set_union(scratch.begin(), scratch.end(), keys.begin(), keys.end(),
+        std::back_inserter(merged));
+    scratch.swap(merged);
+    rebuildFromScratch();
+}
+
+bool PackedMemoryArray::forEachElement(const std::function<void(int)>& visit) {
+    for (size_t segment = 0; segment < segmentCount; ++segment) {
+        const int* keys = slots.data() + segment * segmentSize;
+        for (int i = 0; i < counts[segment]; ++i) {
+            visit(keys[i]);
+        }
+    }
+    return true;
+}
+
+size_t PackedMemoryArray::count() const {
+    return size;
+}
+
+std::string PackedMemoryArray::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer);
+    }
+    return stream.str();
+}
+
+void PackedMemoryArray::writeTo(BufferedWriter& writer) const {
+    writer.write("Size: ");
+    writer.write(static_cast<int>(size));
+    writer.write("\nCapacity: ");
+    writer.write(static_cast<int>(capacity()));
+    writer.write("\nElements:\n");
+
+    bool first = true;
+    for (size_t segment = 0; segment < segmentCount; ++segment) {
+        const int* keys = slots.data() + segment * segmentSize;
+        for (int i = 0; i < counts[segment]; ++i) {
+            if (!first) {
+                writer.write(" ");
+            }
+            writer.write(keys[i]);
+            first = false;
+        }
+    }
+    writer.write("\n");
+}
+
+size_t PackedMemoryArray::memoryUsage() {
+    return slots.capacity() * sizeof(int)
+        + counts.capacity() * sizeof(int)
+        + index.capacity() * sizeof(IndexBlock)
+        + blockKeys.capacity() * sizeof(int)
+        + scratch.capacity() * sizeof(int);
+}
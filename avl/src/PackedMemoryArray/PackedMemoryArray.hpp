@@ -0,0 +1,231 @@
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+#include "../Dict/Dict.h"
+
+class BufferedWriter;
+
+/**
+ * @class PackedMemoryArray
+ * @brief A sorted array with gaps spread through it, so that inserting only moves a few
+ *        keys and an ordered scan reads memory sequentially.
+ *
+ * The array is cut into segments of Θ(log n) slots. Each segment keeps its keys sorted
+ * and packed at its start, followed by its gaps, so a key is inserted by shifting the
+ * rest of one segment. When a segment is full the insertion looks at aligned windows of
+ * 2, 4, 8... segments, as in an implicit binary tree over the segments, and spreads the
+ * keys of the first window that is not too dense evenly over it. Windows higher up must
+ * be sparser (from `LEAF_DENSITY` at one segment down to `ROOT_DENSITY` for the whole
+ * array), which gives amortized O(log² n) moves per insertion. When the whole array
+ * passes `ROOT_DENSITY` it doubles; when it drops under `MIN_DENSITY` it halves.
+ * Erasing works the other way around: when a segment runs out of keys the erase looks
+ * for the first window that is not too sparse (from one key per segment up to
+ * `MIN_DENSITY` for the whole array) and spreads it, so no segment stays empty unless
+ * the array has fewer keys than segments.
+ *
+ * Searches go through a static index over the segments: the first key of every segment,
+ * in 32-byte aligned blocks of 16 that are compared with one `simd::countNotGreater`,
+ * plus the first key of every block, which is searched with a binary search. An empty
+ * segment repeats the key of the segment before it, so the index stays sorted.
+ */
+class PackedMemoryArray : public Dict {
+    protected:
+        /// Slots of the smallest array.
+        static const size_t MIN_CAPACITY = 64;
+        /// Slots of the smallest segment.
+        static const size_t MIN_SEGMENT = 16;
+        /// Segment keys per index block.
+        static const size_t INDEX_KEYS = 16;
+        /// Densest a single segment can be.
+        static constexpr double LEAF_DENSITY = 1.0;
+        /// Densest the whole array can be before it grows.
+        static constexpr double ROOT_DENSITY = 0.75;
+        /// Sparsest the whole array can be before it shrinks.
+        static constexpr double MIN_DENSITY = 0.125;
+
+        /**
+         * @struct IndexBlock
+         * @brief The first key of 16 consecutive segments, padded with `INT_MAX`.
+         */
+        struct alignas(32) IndexBlock {
+            int keys[INDEX_KEYS];
+        };
+
+        std::vector<int> slots;          /// The segments, one after the other.
+        std::vector<int> counts;         /// Keys in use at the start of each segment.
+        std::vector<IndexBlock> index;   /// First key of each segment.
+        std::vector<int> blockKeys;      /// First key of each index block.
+        std::vector<int> scratch;        /// Keys of the window being spread.
+        size_t segmentSize;              /// Slots per segment, a power of two.
+        size_t segmentCount;             /// Segments, a power of two.
+        size_t size;                     /// Number of keys.
+
+        /**
+         * @brief Devuelve la capacidad total del arreglo.
+         */
+        size_t capacity() const;
+
+        /**
+         * @brief Devuelve la primera llave del segmento según el índice.
+         */
+        int indexKey(size_t segment) const;
+
+        /**
+         * @brief Devuelve el segmento donde está o debería estar `key`.
+         *
+         * @effect Busca en el índice el último segmento cuya primera llave no pasa de `key` y,
+         *         si está vacío, retrocede hasta el último segmento con llaves.
+         */
+        size_t findSegment(int key) const;
+
+        /**
+         * @brief Devuelve la posición de la primera llave del segmento que no es menor que `key`.
+         */
+        size_t lowerBound(size_t segment, int key) const;
+
+        /**
+         * @brief Actualiza el índice de los segmentos [first, last) y de los segmentos vacíos
+         *        que los siguen.
+         */
+        void refreshIndex(size_t first, size_t last);
+
+        /**
+         * @brief Reparte `scratch` en partes iguales entre los segmentos [first, last).
+         */
+        void spread(size_t first, size_t last);
+
+        /**
+         * @brief Copia al final de `scratch` las llaves de los segmentos [first, last), en orden.
+         */
+        void gather(size_t first, size_t last);
+
+        /**
+         * @brief Reemplaza el arreglo por uno dimensionado para las llaves de `scratch`.
+         *
+         * @effect Elige la menor capacidad potencia de dos donde las llaves ocupan a lo sumo
+         *         la mitad, con segmentos de una potencia de dos mayor o igual a log2 de la
+         *         capacidad, y las reparte en partes iguales.
+         */
+        void rebuildFromScratch();
+
+        /**
+         * @brief Devuelve la densidad máxima de una ventana a `height` niveles sobre un segmento.
+         */
+        double densityLimit(size_t height) const;
+
+        /**
+         * @brief Devuelve la densidad mínima de una ventana a `height` niveles sobre un segmento.
+         *
+         * @effect Crece desde una llave por segmento hasta `MIN_DENSITY` en la raíz, así que
+         *         una ventana que cumple el límite deja al menos una llave en cada segmento.
+         */
+        double sparsityLimit(size_t height) const;
+
+        /**
+         * @brief Reparte la ventana más chica alrededor de `segment` que no quede demasiado
+         *        rala, para que el segmento vacío vuelva a tener llaves.
+         *
+         * @require `segment` está vacío y el arreglo no está por debajo de `MIN_DENSITY`.
+         */
+        void refill(size_t segment);
+
+        /**
+         * @brief Escribe el tamaño, la capacidad y las llaves en orden.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+    public:
+        /**
+         * @brief Constructs an empty array with `MIN_CAPACITY` slots.
+         */
+        PackedMemoryArray();
+
+        /**
+         * @brief Inserta un elemento moviendo las llaves de un solo segmento, o repartiendo la
+         *        ventana más chica que no quede demasiado densa.
+         *
+         * @effect Si el arreglo completo pasaría de `ROOT_DENSITY`, primero duplica su capacidad.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está presente, con el índice y una búsqueda binaria
+         *        en su segmento.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el arreglo, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento corriendo el resto de su segmento.
+         *
+         * @effect Si el arreglo completo queda por debajo de `MIN_DENSITY`, lo reconstruye a la
+         *         mitad de la capacidad; si no, y el segmento quedó vacío, reparte la ventana
+         *         más chica que no quede demasiado rala.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Inserta un lote mezclándolo con las llaves actuales y repartiendo el resultado.
+         *
+         * @effect Si el lote es chico respecto al arreglo, inserta sus llaves una por una.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Llama a `visit` con cada llave en orden ascendente.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve la cantidad de llaves del arreglo.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Llama a `visit` con cada llave de [lo, hi) en orden ascendente.
+         *
+         * @effect Busca el segmento de `lo` en el índice y recorre los segmentos en orden,
+         *         saltando los huecos de cada uno.
+         *
+         * @require `visit` no debe insertar ni eliminar llaves del arreglo.
+         *
+         * @param lo El límite inferior, incluido.
+         * @param hi El límite superior, excluido.
+         * @param visit Se llama con cada llave del intervalo.
+         */
+        template <typename Visitor>
+        void forEachInRange(int lo, int hi, Visitor visit) const {
+            if (size == 0 || lo >= hi) {
+                return;
+            }
+            size_t segment = findSegment(lo);
+            size_t position = lowerBound(segment, lo);
+            for (; segment < segmentCount; ++segment, position = 0) {
+                const int* keys = slots.data() + segment * segmentSize;
+                for (int last = counts[segment]; position < static_cast<size_t>(last); ++position) {
+                    if (keys[position] >= hi) {
+                        return;
+                    }
+                    visit(keys[position]);
+                }
+            }
+        }
+
+        /**
+         * @brief Devuelve el tamaño, la capacidad y las llaves en orden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes del arreglo, los contadores y el índice.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,283 @@
+#include "PersistentAVLTree.hpp"
+#include <algorithm>
+
+PersistentAVLTree::PersistentNode::PersistentNode(int data, PersistentNode* left,
+        PersistentNode* right)
+    : data(data)
+    , height(std::max(PersistentAVLTree::height(left), PersistentAVLTree::height(right)) + 1)
+    , left(left)
+    , right(right)
+    , references(1) {
+}
+
+PersistentAVLTree::Snapshot::Snapshot(PersistentNode* root, size_t size)
+    : root(root)
+    , size(size) {
+}
+
+PersistentAVLTree::Snapshot::Snapshot(const Snapshot& other)
+    : root(acquire(other.root))
+    , size(other.size) {
+}
+
+PersistentAVLTree::Snapshot& PersistentAVLTree::Snapshot::operator=(const Snapshot& other) {
+    // Tomar la referencia nueva antes de soltar la vieja, por si son la misma versión
+    PersistentNode* previous = root;
+    root = acquire(other.root);
+    size = other.size;
+    release(previous);
+    return *this;
+}
+
+PersistentAVLTree::Snapshot::~Snapshot() {
+    release(root);
+}
+
+bool PersistentAVLTree::Snapshot::contains(int element) const {
+    return PersistentAVLTree::contains(root, element);
+}
+
+size_t PersistentAVLTree::Snapshot::count() const {
+    return size;
+}
+
+void PersistentAVLTree::Snapshot::forEach(const std::function<void(int)>& visit) const {
+    PersistentAVLTree::forEach(root, visit);
+}
+
+std::string PersistentAVLTree::Snapshot::toString() const {
+    std::string result;
+    result += "Size: " + std::to_string(size) + "\n";
+    result += "Elements:\n";
+    PersistentAVLTree::toString(root, result);
+    return result;
+}
+
+PersistentAVLTree::PersistentAVLTree()
+    : root(nullptr)
+    , size(0) {
+}
+
+PersistentAVLTree::~PersistentAVLTree() {
+    release(root);
+}
+
+int PersistentAVLTree::height(const PersistentNode* node) {
+    return (node == nullptr) ? -1 : node->height;
+}
+
+PersistentAVLTree::PersistentNode* PersistentAVLTree::acquire(PersistentNode* node) {
+    if (node != nullptr) {
+        node->references.fetch_add(1, std::memory_order_relaxed);
+    }
+    return node;
+}
+
+void PersistentAVLTree::release(PersistentNode* node) {
+    // Bajar por los hijos solo mientras cada nodo liberado era la última referencia
+    while (node != nullptr && node->references.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        PersistentNode* left = node->left;
+        PersistentNode* right = node->right;
+        delete node;
+        release(left);
+        node = right;
+    }
+}
+
+bool PersistentAVLTree::contains(const PersistentNode* node, int element) {
+    while (node != nullptr) {
+        if (element < node->data) {
+            node = node->left;
+        } else if (element > node->data) {
+            node = node->right;
+        } else {
+            return true;
+        }
+    }
+    return false;
+}
+
+PersistentAVLTree::PersistentNode* PersistentAVLTree::balance(int data, PersistentNode* left,
+        PersistentNode* right) {
+    int balanceFactor = height(left) - height(right);
+
+    if (balanceFactor > 1) {
+        PersistentNode* result;
+        if (height(left->left) >= height(left->right)) {
+            // Caso Left Left: el hijo izquierdo sube
+            result = new PersistentNode(left->data, acquire(left->left),
+                new PersistentNode(data, acquire(left->right), right));
+        } else {
+            // Caso Left Right: el nieto interior sube
+            PersistentNode* inner = left->right;
+            result = new PersistentNode(inner->data,
+                new PersistentNode(left->data, acquire(left->left), acquire(inner->left)),
+                new PersistentNode(data, acquire(inner->right), right));
+        }
+        // La copia de `left` del camino queda sin usar; sus hijos ya tienen otra referencia
+        release(left);
+        return result;
+    }
+
+    if (balanceFactor < -1) {
+        PersistentNode* result;
+        if (height(right->right) >= height(right->left)) {
+            // Caso Right Right
+            result = new PersistentNode(right->data,
+                new PersistentNode(data, left, acquire(right->left)), acquire(right->right));
+        } else {
+            // Caso Right Left
+            PersistentNode* inner = right->left;
+            result = new PersistentNode(inner->data,
+                new PersistentNode(data, left, acquire(inner->left)),
+                new PersistentNode(right->data, acquire(inner->right), acquire(right->right)));
+        }
+        release(right);
+        return result;
+    }
+
+    return new PersistentNode(data, left, right);
+}
+
+PersistentAVLTree::PersistentNode* PersistentAVLTree::insert(PersistentNode* node, int element) {
+    if (node == nullptr) {
+        return new PersistentNode(element, nullptr, nullptr);
+    }
+
+    if (element < node->data) {
+        PersistentNode* left = insert(node->left, element);
+        if (left == nullptr) {
+            return nullptr;
+        }
+        return balance(node->data, left, acquire(node->right));
+    }
+    if (element > node->data) {
+        PersistentNode* right = insert(node->right, element);
+        if (right == nullptr) {
+            return nullptr;
+        }
+        return balance(node->data, acquire(node->left), right);
+    }
+    return nullptr; // element already exists in the tree
+}
+
+PersistentAVLTree::PersistentNode* PersistentAVLTree::erase(PersistentNode* node, int element,
+        bool& removed) {
+    if (node == nullptr) {
+        removed = false;
+        return nullptr;
+    }
+
+    if (element < node->data) {
+        PersistentNode* left = erase(node->left, element, removed);
+        if (!removed) {
+            return nullptr;
+        }
+        return balance(node->data, left, acquire(node->right));
+    }
+    if (element > node->data) {
+        PersistentNode* right = erase(node->right, element, removed);
+        if (!removed) {
+            return nullptr;
+        }
+        return balance(node->data, acquire(node->left), right);
+    }
+
+    removed = true;
+    if (node->left == nullptr) {
+        return acquire(node->right);
+    }
+    if (node->right == nullptr) {
+        return acquire(node->left);
+    }
+
+    // Con dos hijos, el sucesor en orden toma el lugar del nodo
+    int successor;
+    PersistentNode* right = eraseMinimum(node->right, successor);
+    return balance(successor, acquire(node->left), right);
+}
+
+PersistentAVLTree::PersistentNode* PersistentAVLTree::eraseMinimum(PersistentNode* node,
+        int& minimum) {
+    if (node->left == nullptr) {
+        minimum = node->data;
+        return acquire(node->right);
+    }
+    PersistentNode* left = eraseMinimum(node->left, minimum);
+    return balance(node->data, left, acquire(node->right));
+}
+
+void PersistentAVLTree::publish(PersistentNode* newRoot, size_t newSize) {
+    PersistentNode* previous;
+    {
+        std::lock_guard<SpinLock> lock(rootLock);
+        previous = root;
+        root = newRoot;
+        size = newSize;
+    }
+    // Liberar fuera del candado: los nodos del camino viejo pueden ser muchos
+    release(previous);
+}
+
+void PersistentAVLTree::insert(int element) {
+    std::lock_guard<std::mutex> writer(writerMutex);
+    // Solo este hilo cambia `root`, así que puede leerlo sin `rootLock`
+    PersistentNode* newRoot = insert(root, element);
+    if (newRoot != nullptr) {
+        publish(newRoot, size + 1);
+    }
+}
+
+bool PersistentAVLTree::contains(int element) {
+    return snapshot().contains(element);
+}
+
+void PersistentAVLTree::erase(int element) {
+    std::lock_guard<std::mutex> writer(writerMutex);
+    bool removed = false;
+    PersistentNode* newRoot = erase(root, element, removed);
+    if (removed) {
+        publish(newRoot, size - 1);
+    }
+}
+
+PersistentAVLTree::Snapshot PersistentAVLTree::snapshot() {
+    std::lock_guard<SpinLock> lock(rootLock);
+    return Snapshot(acquire(root), size);
+}
+
+bool PersistentAVLTree::forEachElement(const std::function<void(int)>& visit) {
+    snapshot().forEach(visit);
+    return true;
+}
+
+void PersistentAVLTree::forEach(const PersistentNode* node,
+        const std::function<void(int)>& visit) {
+    if (node == nullptr) {
+        return;
+    }
+    forEach(node->left, visit);
+    visit(node->data);
+    forEach(node->right, visit);
+}
+
+std::string PersistentAVLTree::toString() {
+    return snapshot().toString();
+}
+
+void PersistentAVLTree::toString(const PersistentNode* node, std::string& result) {
+    if (node == nullptr) {
+        return;
+    }
+
+    result += "Node: " + std::to_string(node->data) + "-->";
+    result += " Height: " + std::to_string(node->height + 1);
+    result += " References: " + std::to_string(node->references.load()) + "\n";
+    toString(node->left, result);
+    toString(node->right, result);
+}
+
+size_t PersistentAVLTree::memoryUsage() {
+    std::lock_guard<SpinLock> lock(rootLock);
+    return size * sizeof(PersistentNode);
+}
@@ -0,0 +1,222 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include "../Concurrency/SpinLock.hpp"
+#include "../Dict/Dict.h"
+
+/**
+ * @class PersistentAVLTree
+ * @brief An AVL tree whose versions are immutable, so a snapshot costs O(1).
+ *
+ * Nodes are never modified once built. `insert` and `erase` copy only the nodes on the
+ * path from the root to the changed leaf, rebalancing the copies while the recursion
+ * unwinds, and share every other subtree with the previous version; the new root is
+ * then published as the current version. Because a node can have many parents it has
+ * no `parent` pointer, and `balance` works on the way back up instead of walking up.
+ *
+ * Each node counts the versions and parents that reference it and is freed when the
+ * last one goes away, so a `Snapshot` keeps its whole version alive and readable without
+ * locks for as long as it exists. Writers are serialized by a mutex; only the swap of the
+ * root pointer is shared with the threads taking snapshots.
+ */
+class PersistentAVLTree : public Dict {
+    protected:
+        /**
+         * @struct PersistentNode
+         * @brief An immutable node shared by every version that reaches it.
+         */
+        struct PersistentNode {
+            PersistentNode(int data, PersistentNode* left, PersistentNode* right);
+
+            const int data;
+            const int height;             /// Height of the subtree, 0 for a leaf.
+            PersistentNode* const left;   /// Left child, owning one reference.
+            PersistentNode* const right;  /// Right child, owning one reference.
+            std::atomic<int> references;  /// Parents, roots and snapshots holding the node.
+        };
+
+        std::mutex writerMutex;  /// Serializes `insert` and `erase`.
+        SpinLock rootLock;       /// Guards `root` while it is swapped or referenced.
+        PersistentNode* root;    /// Root of the current version, owning one reference.
+        size_t size;             /// Number of keys in the current version.
+
+        /**
+         * @brief Devuelve la altura de un nodo, -1 si es nulo.
+         */
+        static int height(const PersistentNode* node);
+
+        /**
+         * @brief Agrega una referencia a `node`, si no es nulo.
+         *
+         * @return El mismo nodo, para encadenar la llamada al compartir un subárbol.
+         */
+        static PersistentNode* acquire(PersistentNode* node);
+
+        /**
+         * @brief Quita una referencia a `node` y lo libera junto con los hijos que dejen de
+         *        estar referenciados.
+         */
+        static void release(PersistentNode* node);
+
+        /**
+         * @brief Busca `element` en la versión que empieza en `node`.
+         */
+        static bool contains(const PersistentNode* node, int element);
+
+        /**
+         * @brief Construye un nodo nuevo con `data` e hijos `left` y `right`, rotando si
+         *        sus alturas difieren en más de uno.
+         *
+         * @require `left` y `right` deben traer una referencia cada uno, que pasa al
+         *          resultado; sus alturas difieren a lo sumo en dos.
+         *
+         * @return La raíz balanceada del subárbol, con una referencia para quien llama.
+         */
+        static PersistentNode* balance(int data, PersistentNode* left, PersistentNode* right);
+
+        /**
+         * @brief Copia el camino de `node` hasta donde va `element` y lo cuelga ahí.
+         *
+         * @return La raíz nueva del subárbol, o nullptr si la llave ya estaba.
+         */
+        static PersistentNode* insert(PersistentNode* node, int element);
+
+        /**
+         * @brief Copia el camino de `node` hasta `element` y lo quita.
+         *
+         * @param removed Se pone en true si la llave estaba en el subárbol.
+         * @return La raíz nueva del subárbol, con una referencia para quien llama.
+         */
+        static PersistentNode* erase(PersistentNode* node, int element, bool& removed);
+
+        /**
+         * @brief Copia el camino hasta el mínimo de `node` y lo quita.
+         *
+         * @param minimum Recibe la llave quitada.
+         * @return La raíz nueva del subárbol, con una referencia para quien llama.
+         */
+        static PersistentNode* eraseMinimum(PersistentNode* node, int& minimum);
+
+        /**
+         * @brief Llama a `visit` con las llaves del subárbol en orden.
+         */
+        static void forEach(const PersistentNode* node, const std::function<void(int)>& visit);
+
+        /**
+         * @brief Agrega a `result` los nodos del subárbol en preorden.
+         */
+        static void toString(const PersistentNode* node, std::string& result);
+
+        /**
+         * @brief Hace de `newRoot` la versión actual y suelta la anterior.
+         */
+        void publish(PersistentNode* newRoot, size_t newSize);
+
+    public:
+        /**
+         * @class Snapshot
+         * @brief A read-only version of the tree that stays valid while writers continue.
+         *
+         * Copying a snapshot only adds a reference to its root. Any number of threads can
+         * read the same snapshot at once without taking a lock.
+         */
+        class Snapshot {
+            public:
+                Snapshot(const Snapshot& other);
+                Snapshot& operator=(const Snapshot& other);
+                ~Snapshot();
+
+                /**
+                 * @brief Verifica si un elemento estaba en el árbol al tomar la instantánea.
+                 */
+                bool contains(int element) const;
+
+                /**
+                 * @brief Devuelve la cantidad de llaves de la versión.
+                 */
+                size_t count() const;
+
+                /**
+                 * @brief Llama a `visit` con cada llave de la versión en orden ascendente.
+                 */
+                void forEach(const std::function<void(int)>& visit) const;
+
+                /**
+                 * @brief Devuelve el tamaño de la versión y sus nodos en preorden.
+                 */
+                std::string toString() const;
+
+            private:
+                friend class PersistentAVLTree;
+
+                Snapshot(PersistentNode* root, size_t size);
+
+                PersistentNode* root;  /// Root of the version, owning one reference.
+                size_t size;           /// Number of keys in the version.
+        };
+
+        /**
+         * @brief Constructs an empty tree.
+         */
+        PersistentAVLTree();
+
+        PersistentAVLTree(const PersistentAVLTree&) = delete;
+        PersistentAVLTree& operator=(const PersistentAVLTree&) = delete;
+
+        /**
+         * @brief Drops the current version; nodes still held by snapshots stay alive.
+         */
+        ~PersistentAVLTree();
+
+        /**
+         * @brief Inserta un elemento creando una versión nueva.
+         *
+         * @effect Copia los O(log n) nodos del camino; no altera las instantáneas tomadas.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en la versión actual.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el árbol, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento creando una versión nueva.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Devuelve la versión actual en tiempo constante.
+         */
+        Snapshot snapshot();
+
+        /**
+         * @brief Llama a `visit` con cada llave de la versión actual en orden ascendente.
+         *
+         * @effect Recorre una instantánea, así que los escritores pueden seguir mientras tanto.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño de la versión actual y sus nodos en preorden.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes de los nodos de la versión actual.
+         *
+         * Los nodos que solo siguen vivos por instantáneas viejas no se cuentan.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,62 @@
+#include "BufferedWriter.hpp"
+#include <charconv>
+#include <cstring>
+
+BufferedWriter::BufferedWriter(std::ostream& stream)
+    : stream(&stream)
+    , file(nullptr)
+    , used(0)
+    , failed(false) {
+}
+
+BufferedWriter::BufferedWriter(FILE* file)
+    : stream(nullptr)
+    , file(file)
+    , used(0)
+    , failed(false) {
+}
+
+BufferedWriter::~BufferedWriter() {
+    flush();
+}
+
+void BufferedWriter::write(const char* text, size_t length) {
+    if (used + length > CAPACITY) {
+        flush();
+        // Un texto más grande que el buffer se escribe directo
+        if (length > CAPACITY) {
+            if (stream != nullptr) {
+                stream->write(text, length);
+                failed |= !stream->good();
+            } else {
+                failed |= std::fwrite(text, 1, length, file) != length;
+            }
+            return;
+        }
+    }
+    std::memcpy(buffer + used, text, length);
+    used += length;
+}
+
+void BufferedWriter::write(int value) {
+    if (used + INT_DIGITS > CAPACITY) {
+        flush();
+    }
+    char* end = std::to_chars(buffer + used, buffer + CAPACITY, value).ptr;
+    used = end - buffer;
+}
+
+bool BufferedWriter::flush() {
+    if (used > 0) {
+        if (stream != nullptr) {
+            stream->write(buffer, used);
+        } else {
+            failed |= std::fwrite(buffer, 1, used, file) != used;
+        }
+        used = 0;
+    }
+    if (stream != nullptr) {
+        failed |= !stream->good();
+    }
+    return !failed;
+}
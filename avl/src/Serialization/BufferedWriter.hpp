@@ -0,0 +1,70 @@
+#pragma once
+#include <cstddef>
+#include <cstdio>
+#include <ostream>
+
+/**
+ * @class BufferedWriter
+ * @brief Collects text in a fixed-size buffer and hands it to a stream or a `FILE*` in blocks.
+ *
+ * The tree dumps write one short line per node; going through this buffer turns them into
+ * a few large writes and keeps memory constant no matter how big the tree is. Integers are
+ * formatted in place with `std::to_chars`, without building a `std::string` per number.
+ */
+class BufferedWriter {
+    public:
+        /**
+         * @brief Writes to `stream`, which must outlive the writer.
+         */
+        explicit BufferedWriter(std::ostream& stream);
+
+        /**
+         * @brief Writes to `file`, which must be open for writing and outlive the writer.
+         */
+        explicit BufferedWriter(FILE* file);
+
+        BufferedWriter(const BufferedWriter&) = delete;
+        BufferedWriter& operator=(const BufferedWriter&) = delete;
+
+        /**
+         * @brief Flushes whatever is still in the buffer.
+         */
+        ~BufferedWriter();
+
+        /**
+         * @brief Appends `length` characters of `text`.
+         */
+        void write(const char* text, size_t length);
+
+        /**
+         * @brief Appends a string literal, without its terminating null.
+         */
+        template <size_t length>
+        void write(const char (&text)[length]) {
+            write(text, length - 1);
+        }
+
+        /**
+         * @brief Appends the decimal representation of `value`.
+         */
+        void write(int value);
+
+        /**
+         * @brief Hands the buffered text to the destination.
+         *
+         * @return false if the destination reported an error, now or in an earlier flush.
+         */
+        bool flush();
+
+    private:
+        /// Size of the buffer, a few pages so each write to the destination is worth it.
+        static const size_t CAPACITY = 1 << 14;
+        /// Room needed to format any `int`, sign included.
+        static const size_t INT_DIGITS = 12;
+
+        std::ostream* stream;  /// Destination, or nullptr when writing to `file`.
+        FILE* file;            /// Destination, or nullptr when writing to `stream`.
+        size_t used;           /// Characters waiting in `buffer`.
+        bool failed;           /// Whether any write to the destination failed.
+        char buffer[CAPACITY];
+};
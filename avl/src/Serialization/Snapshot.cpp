@@ -0,0 +1,129 @@
+#include "Snapshot.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static const char SNAPSHOT_MAGIC[8] = {'D', 'I', 'C', 'T', 'S', 'N', 'A', 'P'};
+static const uint64_t FNV_OFFSET = 14695981039346656037ull;
+static const uint64_t FNV_PRIME = 1099511628211ull;
+
+SnapshotWriter::SnapshotWriter(FILE* file)
+    : file(file)
+    , writer(file)
+    , count(0)
+    , checksum(FNV_OFFSET)
+    , last(0)
+    , ascending(true) {
+    // Reservar el lugar del encabezado; `finish` lo reescribe con los valores finales
+    SnapshotHeader header = {};
+    writer.write(reinterpret_cast<const char*>(&header), sizeof(header));
+}
+
+void SnapshotWriter::add(int key) {
+    if (count > 0 && key <= last) {
+        ascending = false;
+    }
+    writer.write(reinterpret_cast<const char*>(&key), sizeof(key));
+    checksum = (checksum ^ static_cast<uint32_t>(key)) * FNV_PRIME;
+    last = key;
+    count++;
+}
+
+bool SnapshotWriter::finish() {
+    if (!writer.flush()) {
+        return false;
+    }
+
+    SnapshotHeader header = {};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SnapshotHeader::VERSION;
+    header.byteOrder = SnapshotHeader::ORDER_MARK;
+    header.count = count;
+    header.checksum = checksum;
+    if (std::fseek(file, 0, SEEK_SET) != 0
+            || std::fwrite(&header, sizeof(header), 1, file) != 1
+            || std::fflush(file) != 0) {
+        return false;
+    }
+    return ascending;
+}
+
+MappedSnapshot::MappedSnapshot(const char* path, bool verify)
+    : mapping(nullptr)
+    , length(0)
+    , data(nullptr)
+    , size(0) {
+    int descriptor = ::open(path, O_RDONLY);
+    if (descriptor < 0) {
+        throw std::runtime_error(std::string("cannot open snapshot ") + path);
+    }
+    struct stat status;
+    if (::fstat(descriptor, &status) != 0 || status.st_size < (off_t) sizeof(SnapshotHeader)) {
+        ::close(descriptor);
+        throw std::runtime_error(std::string("snapshot too short: ") + path);
+    }
+    length = static_cast<size_t>(status.st_size);
+    mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, descriptor, 0);
+    // La proyección sigue válida después de cerrar el descriptor
+    ::close(descriptor);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        throw std::runtime_error(std::string("cannot map snapshot ") + path);
+    }
+
+    const SnapshotHeader* header = static_cast<const SnapshotHeader*>(mapping);
+    const char* problem = nullptr;
+    if (std::memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+        problem = "not a snapshot: ";
+    } else if (header->version != SnapshotHeader::VERSION
+            || header->byteOrder != SnapshotHeader::ORDER_MARK) {
+        problem = "unsupported snapshot version or byte order: ";
+    } else if (header->count * sizeof(int) != length - sizeof(SnapshotHeader)) {
+        problem = "truncated snapshot: ";
+    }
+    if (problem == nullptr) {
+        data = reinterpret_cast<const int*>(header + 1);
+        size = header->count;
+        if (verify && checksum(data, size) != header->checksum) {
+            problem = "corrupted snapshot: ";
+        }
+    }
+    if (problem != nullptr) {
+        ::munmap(mapping, length);
+        mapping = nullptr;
+        throw std::runtime_error(problem + std::string(path));
+    }
+}
+
+MappedSnapshot::~MappedSnapshot() {
+    if (mapping != nullptr) {
+        ::munmap(mapping, length);
+    }
+}
+
+const int* MappedSnapshot::keys() const {
+    return data;
+}
+
+size_t MappedSnapshot::count() const {
+    return size;
+}
+
+bool MappedSnapshot::contains(int element) const {
+    const int* end = data + size;
+    const int* found = std::lower_bound(data, end, element);
+    return found != end && *found == element;
+}
+
+uint64_t MappedSnapshot::checksum(const int* keys, size_t count) {
+    uint64_t hash = FNV_OFFSET;
+    for (size_t i = 0; i < count; ++i) {
+        hash = (hash ^ static_cast<uint32_t>(keys[i])) * FNV_PRIME;
+    }
+    return hash;
+}
@@ -0,0 +1,118 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include "BufferedWriter.hpp"
+
+/**
+ * @struct SnapshotHeader
+ * @brief The first bytes of a snapshot file; the keys follow it in ascending order.
+ *
+ * Keys are stored as native 32-bit integers, so `byteOrder` lets a reader on a machine
+ * with a different endianness reject the file instead of misreading it. The checksum is
+ * FNV-1a taken one key at a time instead of one byte at a time, which is enough to catch
+ * truncated or corrupted files at a quarter of the cost.
+ */
+struct SnapshotHeader {
+    char magic[8];       /// "DICTSNAP".
+    uint32_t version;    /// Format version, currently 1.
+    uint32_t byteOrder;  /// `SnapshotHeader::ORDER_MARK` as written by the saving machine.
+    uint64_t count;      /// Number of keys after the header.
+    uint64_t checksum;   /// FNV-1a of the keys.
+
+    static const uint32_t VERSION = 1;
+    static const uint32_t ORDER_MARK = 0x01020304;
+};
+
+/**
+ * @class SnapshotWriter
+ * @brief Streams ascending keys into a snapshot file and writes its header at the end.
+ *
+ * The header is first written with a zero count and checksum, then overwritten once every
+ * key has gone through, so a dictionary can be saved in one in-order walk without copying
+ * its keys into an array first.
+ */
+class SnapshotWriter {
+    public:
+        /**
+         * @brief Starts a snapshot at the beginning of `file`.
+         *
+         * @require `file` must be open for binary writing and support seeking.
+         */
+        explicit SnapshotWriter(FILE* file);
+
+        /**
+         * @brief Appends the next key.
+         *
+         * @require `key` must be greater than every key added before.
+         */
+        void add(int key);
+
+        /**
+         * @brief Writes the remaining keys and the final header.
+         *
+         * @return false if any write failed or the keys were not strictly ascending.
+         */
+        bool finish();
+
+    private:
+        FILE* file;
+        BufferedWriter writer;
+        uint64_t count;
+        uint64_t checksum;
+        int last;
+        bool ascending;
+};
+
+/**
+ * @class MappedSnapshot
+ * @brief A snapshot file mapped read-only into memory.
+ *
+ * Opening validates the header and, unless asked not to, the checksum. The keys are then
+ * served straight from the mapping: `keys()` can feed a bulk load in O(n), and `contains`
+ * answers with a binary search without building any structure at all.
+ */
+class MappedSnapshot {
+    public:
+        /**
+         * @brief Maps the snapshot at `path`.
+         *
+         * @param verify Whether to check the checksum, which reads every key once.
+         * @throws std::runtime_error if the file cannot be mapped or is not a valid snapshot.
+         */
+        explicit MappedSnapshot(const char* path, bool verify = true);
+
+        MappedSnapshot(const MappedSnapshot&) = delete;
+        MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+        /**
+         * @brief Unmaps the file.
+         */
+        ~MappedSnapshot();
+
+        /**
+         * @brief Returns the keys in ascending order; valid while the snapshot lives.
+         */
+        const int* keys() const;
+
+        /**
+         * @brief Returns the number of keys.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Checks whether `element` is in the snapshot with a binary search.
+         */
+        bool contains(int element) const;
+
+        /**
+         * @brief Returns the FNV-1a checksum of `count` keys.
+         */
+        static uint64_t checksum(const int* keys, size_t count);
+
+    private:
+        void* mapping;     /// Start of the mapped file.
+        size_t length;     /// Bytes mapped.
+        const int* data;   /// First key, right after the header.
+        size_t size;       /// Number of keys.
+};
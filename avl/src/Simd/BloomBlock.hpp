@@ -0,0 +1,84 @@
+#pragma once
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Sets and tests the bits of one block of a split-block Bloom filter at once
+namespace simd {
+
+/// 32-bit words per block; every key sets one bit in each word.
+const int BLOOM_BLOCK_WORDS = 8;
+
+/// Odd multipliers that turn one hash into a different bit position per word.
+const uint32_t BLOOM_SALTS[BLOOM_BLOCK_WORDS] = {
+  0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+  0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U
+};
+
+#if defined(__SSE2__)
+/**
+ * @brief Devuelve en cada palabra el bit que le toca a `hash` con cuatro sales.
+ *
+ * @effect Multiplica por cada sal y usa los 5 bits altos como posición. SSE2 no tiene
+ *         producto de 32 bits ni corrimiento variable: el producto se arma con dos
+ *         `_mm_mul_epu32`, y `1 << posición` se obtiene escribiendo la posición en el
+ *         exponente de un float y convirtiéndolo a entero (2^31 no cabe en un int, pero
+ *         la conversión devuelve 0x80000000, que es justo ese bit).
+ */
+inline __m128i bloomMask(uint32_t hash, const uint32_t* salts) {
+  __m128i key = _mm_set1_epi32(static_cast<int>(hash));
+  __m128i salt = _mm_loadu_si128(reinterpret_cast<const __m128i*>(salts));
+  __m128i even = _mm_mul_epu32(key, salt);
+  __m128i odd = _mm_mul_epu32(_mm_srli_epi64(key, 32), _mm_srli_epi64(salt, 32));
+  __m128i product = _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+      _mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+  __m128i exponent = _mm_add_epi32(_mm_srli_epi32(product, 27), _mm_set1_epi32(127));
+  return _mm_cvttps_epi32(_mm_castsi128_ps(_mm_slli_epi32(exponent, 23)));
+}
+#endif
+
+/**
+ * @brief Marca en el bloque los ocho bits de `hash`.
+ *
+ * @require `block` debe tener `BLOOM_BLOCK_WORDS` palabras alineadas a 16 bytes.
+ */
+inline void bloomInsert(uint32_t* block, uint32_t hash) {
+#if defined(__SSE2__)
+  for (int half = 0; half < BLOOM_BLOCK_WORDS; half += 4) {
+    __m128i* words = reinterpret_cast<__m128i*>(block + half);
+    _mm_store_si128(words, _mm_or_si128(_mm_load_si128(words),
+        bloomMask(hash, BLOOM_SALTS + half)));
+  }
+#else
+  for (int i = 0; i < BLOOM_BLOCK_WORDS; ++i) {
+    block[i] |= 1U << ((hash * BLOOM_SALTS[i]) >> 27);
+  }
+#endif
+}
+
+/**
+ * @brief Devuelve true si los ocho bits de `hash` están marcados en el bloque.
+ *
+ * @require `block` debe tener `BLOOM_BLOCK_WORDS` palabras alineadas a 16 bytes.
+ */
+inline bool bloomCheck(const uint32_t* block, uint32_t hash) {
+#if defined(__SSE2__)
+  __m128i missing = _mm_setzero_si128();
+  for (int half = 0; half < BLOOM_BLOCK_WORDS; half += 4) {
+    __m128i mask = bloomMask(hash, BLOOM_SALTS + half);
+    __m128i words = _mm_load_si128(reinterpret_cast<const __m128i*>(block + half));
+    missing = _mm_or_si128(missing, _mm_andnot_si128(words, mask));
+  }
+  return _mm_movemask_epi8(_mm_cmpeq_epi32(missing, _mm_setzero_si128())) == 0xFFFF;
+#else
+  for (int i = 0; i < BLOOM_BLOCK_WORDS; ++i) {
+    if ((block[i] & (1U << ((hash * BLOOM_SALTS[i]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+#endif
+}
+
+}  // namespace simd
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+// Compares groups of 16 control bytes of a hash table at once
+namespace simd {
+
+/// Bytes compared by one call; one SSE2 register.
+const int GROUP_BYTES = 16;
+
+/**
+ * @brief Devuelve una máscara con el bit `i` en 1 si `group[i] == byte`.
+ *
+ * @require `group` debe tener 16 bytes legibles; no hace falta alineación.
+ */
+inline uint32_t matchByte(const int8_t* group, int8_t byte) {
+#if defined(__SSE2__)
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  __m128i equal = _mm_cmpeq_epi8(block, _mm_set1_epi8(byte));
+  return static_cast<uint32_t>(_mm_movemask_epi8(equal));
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < GROUP_BYTES; ++i) {
+    mask |= static_cast<uint32_t>(group[i] == byte) << i;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * @brief Devuelve una máscara con el bit `i` en 1 si `group[i]` es negativo.
+ *
+ * @require `group` debe tener 16 bytes legibles; no hace falta alineación.
+ */
+inline uint32_t matchNegative(const int8_t* group) {
+#if defined(__SSE2__)
+  __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(group));
+  return static_cast<uint32_t>(_mm_movemask_epi8(block));
+#else
+  uint32_t mask = 0;
+  for (int i = 0; i < GROUP_BYTES; ++i) {
+    mask |= static_cast<uint32_t>(group[i] < 0) << i;
+  }
+  return mask;
+#endif
+}
+
+/**
+ * @brief Devuelve la posición del bit en 1 más bajo de una máscara distinta de cero.
+ */
+inline int lowestBit(uint32_t mask) {
+#if defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int bit = 0;
+  while ((mask & 1) == 0) {
+    mask >>= 1;
+    bit++;
+  }
+  return bit;
+#endif
+}
+
+}  // namespace simd
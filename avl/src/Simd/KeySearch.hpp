@@ -0,0 +1,98 @@
+#pragma once
+#include <cstddef>
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+// Searches inside a sorted block of keys with vector compares instead of branches
+namespace simd {
+
+/**
+ * @brief Cuenta los bits en 1 de la máscara que devuelve un movemask.
+ */
+inline int popcount(unsigned int mask) {
+#if defined(__GNUC__)
+  return __builtin_popcount(mask);
+#else
+  int bits = 0;
+  for (; mask != 0; mask &= mask - 1) {
+    bits++;
+  }
+  return bits;
+#endif
+}
+
+/**
+ * @brief Cuenta las llaves del bloque que son menores que `key`.
+ *
+ * Compara todo el bloque a la vez: 8 llaves por instrucción con AVX2, 4 con SSE2 y
+ * una por una si no hay ninguna de las dos. Sin saltos que dependan de las llaves, el
+ * costo es el mismo dondequiera que esté `key`.
+ *
+ * @require `keys` alineado a 32 bytes y `length` múltiplo de 8. Las posiciones sin
+ *          llave deben tener `INT_MAX`, que nunca es menor que `key`.
+ *
+ * @return La posición de la primera llave mayor o igual que `key`.
+ */
+template <size_t length>
+inline size_t countLess(const int* keys, int key) {
+  static_assert(length % 8 == 0, "the block must be a whole number of AVX2 vectors");
+  size_t count = 0;
+#if defined(__AVX2__)
+  const __m256i needle = _mm256_set1_epi32(key);
+  for (size_t i = 0; i < length; i += 8) {
+    __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+    __m256i less = _mm256_cmpgt_epi32(needle, block);
+    count += popcount(_mm256_movemask_ps(_mm256_castsi256_ps(less)));
+  }
+#elif defined(__SSE2__)
+  const __m128i needle = _mm_set1_epi32(key);
+  for (size_t i = 0; i < length; i += 4) {
+    __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+    __m128i less = _mm_cmpgt_epi32(needle, block);
+    count += popcount(_mm_movemask_ps(_mm_castsi128_ps(less)));
+  }
+#else
+  for (size_t i = 0; i < length; ++i) {
+    count += keys[i] < key;
+  }
+#endif
+  return count;
+}
+
+/**
+ * @brief Cuenta las llaves del bloque que son menores o iguales que `key`.
+ *
+ * @require Lo mismo que `countLess`. Si `key` es `INT_MAX` las posiciones de relleno
+ *          también cuentan, así que quien llama debe acotar el resultado por la cantidad
+ *          real de llaves.
+ *
+ * @return La posición de la primera llave mayor que `key`.
+ */
+template <size_t length>
+inline size_t countNotGreater(const int* keys, int key) {
+  static_assert(length % 8 == 0, "the block must be a whole number of AVX2 vectors");
+  size_t greater = 0;
+#if defined(__AVX2__)
+  const __m256i needle = _mm256_set1_epi32(key);
+  for (size_t i = 0; i < length; i += 8) {
+    __m256i block = _mm256_load_si256(reinterpret_cast<const __m256i*>(keys + i));
+    __m256i above = _mm256_cmpgt_epi32(block, needle);
+    greater += popcount(_mm256_movemask_ps(_mm256_castsi256_ps(above)));
+  }
+#elif defined(__SSE2__)
+  const __m128i needle = _mm_set1_epi32(key);
+  for (size_t i = 0; i < length; i += 4) {
+    __m128i block = _mm_load_si128(reinterpret_cast<const __m128i*>(keys + i));
+    __m128i above = _mm_cmpgt_epi32(block, needle);
+    greater += popcount(_mm_movemask_ps(_mm_castsi128_ps(above)));
+  }
+#else
+  for (size_t i = 0; i < length; ++i) {
+    greater += keys[i] > key;
+  }
+#endif
+  return length - greater;
+}
+
+}  // namespace simd
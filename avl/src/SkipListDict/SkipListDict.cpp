@@ -0,0 +1,264 @@
+#include "SkipListDict.hpp"
+#include <climits>
+#include <functional>
+#include <new>
+#include <thread>
+#include "../Concurrency/EpochReclaimer.hpp"
+
+// Estado de xorshift de cada hilo para sortear alturas sin compartir una línea de caché
+static thread_local uint64_t heightState = 0;
+
+SkipListDict::SkipListDict()
+    : head(createNode(INT_MIN, MAX_LEVEL)) {
+}
+
+SkipListDict::~SkipListDict() {
+    SkipNode* node = pointer(head->next(0).load());
+    while (node != nullptr) {
+        SkipNode* next = pointer(node->next(0).load());
+        destroyNode(node);
+        node = next;
+    }
+    destroyNode(head);
+}
+
+bool SkipListDict::isMarked(uintptr_t link) {
+    return (link & 1) != 0;
+}
+
+SkipListDict::SkipNode* SkipListDict::pointer(uintptr_t link) {
+    return reinterpret_cast<SkipNode*>(link & ~static_cast<uintptr_t>(1));
+}
+
+uintptr_t SkipListDict::link(SkipNode* node) {
+    return reinterpret_cast<uintptr_t>(node);
+}
+
+SkipListDict::SkipNode* SkipListDict::createNode(int key, int height) {
+    void* memory = ::operator new(sizeof(SkipNode) + height * sizeof(std::atomic<uintptr_t>));
+    SkipNode* node = new (memory) SkipNode(key, height);
+    for (int level = 0; level < height; ++level) {
+        new (&node->next(level)) std::atomic<uintptr_t>(0);
+    }
+    return node;
+}
+
+void SkipListDict::destroyNode(void* node) {
+    static_cast<SkipNode*>(node)->~SkipNode();
+    ::operator delete(node);
+}
+
+int SkipListDict::randomHeight() {
+    if (heightState == 0) {
+        heightState = std::hash<std::thread::id>()(std::this_thread::get_id()) | 1;
+    }
+    heightState ^= heightState << 13;
+    heightState ^= heightState >> 7;
+    heightState ^= heightState << 17;
+
+    // Cada par de bits en cero sube un nivel: probabilidad 1/4 por nivel
+    uint64_t bits = heightState;
+    int height = 1;
+    while (height < MAX_LEVEL && (bits & 3) == 0) {
+        height++;
+        bits >>= 2;
+    }
+    return height;
+}
+
+void SkipListDict::releaseLevels(SkipNode* node, int levels) {
+    if (node->pending.fetch_sub(levels) == levels) {
+        EpochReclaimer::instance().retire(node, destroyNode);
+    }
+}
+
+bool SkipListDict::find(int key, SkipNode** preds, SkipNode** succs) {
+    while (true) {
+        Attempt attempt = attemptFind(key, preds, succs);
+        if (attempt != RETRY) {
+            return attempt == FOUND;
+        }
+    }
+}
+
+SkipListDict::Attempt SkipListDict::attemptFind(int key, SkipNode** preds, SkipNode** succs) {
+    SkipNode* pred = head;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+        SkipNode* curr = pointer(pred->next(level).load());
+        while (curr != nullptr) {
+            uintptr_t succ = curr->next(level).load();
+            if (isMarked(succ)) {
+                // curr está eliminado: sacarlo de este nivel antes de seguir
+                uintptr_t expected = link(curr);
+                if (!pred->next(level).compare_exchange_strong(expected, link(pointer(succ)))) {
+                    return RETRY;
+                }
+                releaseLevels(curr, 1);
+                curr = pointer(succ);
+            } else if (curr->key < key) {
+                pred = curr;
+                curr = pointer(succ);
+            } else {
+                break;
+            }
+        }
+        preds[level] = pred;
+        succs[level] = curr;
+    }
+    return succs[0] != nullptr && succs[0]->key == key ? FOUND : ABSENT;
+}
+
+void SkipListDict::insert(int element) {
+    EpochGuard guard;
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+    SkipNode* node = nullptr;
+
+    while (true) {
+        if (find(element, preds, succs)) {
+            if (node != nullptr) {
+                destroyNode(node); // nunca se publicó
+            }
+            return; // element already exists in the list
+        }
+        if (node == nullptr) {
+            node = createNode(element, randomHeight());
+        }
+        for (int level = 0; level < node->height; ++level) {
+            node->next(level).store(link(succs[level]));
+        }
+
+        // El enlace del nivel inferior es el que hace visible la llave
+        uintptr_t expected = link(succs[0]);
+        if (preds[0]->next(0).compare_exchange_strong(expected, link(node))) {
+            break;
+        }
+    }
+
+    linkUpperLevels(node, preds, succs);
+}
+
+void SkipListDict::linkUpperLevels(SkipNode* node, SkipNode** preds, SkipNode** succs) {
+    for (int level = 1; level < node->height; ++level) {
+        if (!linkLevel(node, level, preds, succs)) {
+            releaseLevels(node, node->height - level);
+            break;
+        }
+    }
+
+    // Si el nodo se marcó antes de enlazar un nivel, el erase pudo no verlo en ese nivel
+    if (isMarked(node->next(0).load())) {
+        find(node->key, preds, succs);
+    }
+}
+
+bool SkipListDict::linkLevel(SkipNode* node, int level, SkipNode** preds, SkipNode** succs) {
+    while (true) {
+        uintptr_t current = node->next(level).load();
+        if (isMarked(current)) {
+            return false; // un erase ya empezó a marcar el nodo
+        }
+        if (current != link(succs[level])
+                && !node->next(level).compare_exchange_strong(current, link(succs[level]))) {
+            continue;
+        }
+
+        uintptr_t expected = link(succs[level]);
+        if (preds[level]->next(level).compare_exchange_strong(expected, link(node))) {
+            return true;
+        }
+        if (!find(node->key, preds, succs) || succs[0] != node) {
+            return false; // el nodo ya salió del nivel inferior
+        }
+    }
+}
+
+bool SkipListDict::contains(int element) {
+    EpochGuard guard;
+
+    SkipNode* pred = head;
+    SkipNode* curr = nullptr;
+    for (int level = MAX_LEVEL - 1; level >= 0; --level) {
+        curr = pointer(pred->next(level).load());
+        while (curr != nullptr) {
+            uintptr_t succ = curr->next(level).load();
+            if (isMarked(succ)) {
+                curr = pointer(succ); // pasar por encima sin desenlazarlo
+            } else if (curr->key < element) {
+                pred = curr;
+                curr = pointer(succ);
+            } else {
+                break;
+            }
+        }
+    }
+    return curr != nullptr && curr->key == element;
+}
+
+void SkipListDict::erase(int element) {
+    EpochGuard guard;
+    SkipNode* preds[MAX_LEVEL];
+    SkipNode* succs[MAX_LEVEL];
+
+    if (!find(element, preds, succs)) {
+        return;
+    }
+    SkipNode* node = succs[0];
+
+    // Marcar de arriba hacia abajo; el nivel inferior decide quién elimina la llave
+    for (int level = node->height - 1; level >= 1; --level) {
+        uintptr_t current = node->next(level).load();
+        while (!isMarked(current)) {
+            node->next(level).compare_exchange_weak(current, current | 1);
+        }
+    }
+
+    uintptr_t current = node->next(0).load();
+    while (!isMarked(current)) {
+        if (node->next(0).compare_exchange_strong(current, current | 1)) {
+            find(element, preds, succs); // desenlaza el nodo de todos sus niveles
+            return;
+        }
+    }
+}
+
+bool SkipListDict::forEachElement(const std::function<void(int)>& visit) {
+    EpochGuard guard;
+    for (SkipNode* node = pointer(head->next(0).load()); node != nullptr;
+            node = pointer(node->next(0).load())) {
+        if (!isMarked(node->next(0).load())) {
+            visit(node->key);
+        }
+    }
+    return true;
+}
+
+std::string SkipListDict::toString() {
+    std::string elements;
+    size_t size = 0;
+    for (SkipNode* node = pointer(head->next(0).load()); node != nullptr;
+            node = pointer(node->next(0).load())) {
+        if (isMarked(node->next(0).load())) {
+            continue;
+        }
+        elements += "Node: " + std::to_string(node->key) + "-->";
+        elements += " Levels: " + std::to_string(node->height);
+        elements += "\n";
+        size++;
+    }
+
+    std::string result;
+    result += "Size: " + std::to_string(size) + "\n";
+    result += "Elements:\n";
+    result += elements;
+    return result;
+}
+
+size_t SkipListDict::memoryUsage() {
+    size_t bytes = sizeof(SkipNode) + MAX_LEVEL * sizeof(std::atomic<uintptr_t>);
+    for (SkipNode* node = pointer(head->next(0).load()); node != nullptr;
+            node = pointer(node->next(0).load())) {
+        bytes += sizeof(SkipNode) + node->height * sizeof(std::atomic<uintptr_t>);
+    }
+    return bytes;
+}
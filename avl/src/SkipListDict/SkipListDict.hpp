@@ -0,0 +1,185 @@
+#pragma once
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include "../Dict/Dict.h"
+
+/**
+ * @class SkipListDict
+ * @brief A lock-free skip list that many threads can read and modify at once.
+ *
+ * It follows the lock-free skip list of Herlihy and Shavit, built on Harris's linked
+ * list: every level is a sorted list whose links are changed only with compare-and-swap.
+ * A node is erased in two steps. First the links that leave it are marked (the low bit
+ * of the pointer), top level first; whoever marks the bottom level owns the erase. Then
+ * any thread that finds a marked node while searching unlinks it from its predecessor.
+ * Insertions link the bottom level first, which is when the key becomes visible, and
+ * then the upper levels one at a time.
+ *
+ * There is no rebalancing step: the height of each node is drawn at random when it is
+ * inserted, so no operation ever touches nodes far from its key. `contains` never writes
+ * and never restarts; it steps over marked nodes instead of unlinking them.
+ *
+ * Each node counts the levels it is still linked in, or could still be linked in. The
+ * thread that brings the count to zero retires the node through the `EpochReclaimer`,
+ * so a thread that still holds a pointer to it never touches freed memory.
+ */
+class SkipListDict : public Dict {
+    protected:
+        /// Levels of the tallest node; with p = 1/4, enough for 4^16 keys.
+        static const int MAX_LEVEL = 16;
+
+        /**
+         * @struct SkipNode
+         * @brief A key followed by `height` atomic links, allocated together.
+         */
+        struct alignas(alignof(std::atomic<uintptr_t>)) SkipNode {
+            SkipNode(int key, int height)
+            : key(key)
+            , height(height)
+            , pending(height) {
+            };
+
+            /**
+             * @brief Returns the link of the node at level `level`, with its mark bit.
+             */
+            std::atomic<uintptr_t>& next(int level) {
+                return reinterpret_cast<std::atomic<uintptr_t>*>(this + 1)[level];
+            };
+
+            const int key;             /// The key, fixed for the life of the node.
+            const int height;          /// Number of levels of the node.
+            std::atomic<int> pending;  /// Levels not yet unlinked or given up by the insert.
+        };
+
+        /// Result of a search that may have to start over from the head.
+        enum Attempt {
+            RETRY,
+            ABSENT,
+            FOUND
+        };
+
+        /// Sentinel before every key with `MAX_LEVEL` levels; it is never marked.
+        SkipNode* head;
+
+        static bool isMarked(uintptr_t link);
+        static SkipNode* pointer(uintptr_t link);
+        static uintptr_t link(SkipNode* node);
+
+        /**
+         * @brief Reserva un nodo con `height` enlaces nulos.
+         */
+        static SkipNode* createNode(int key, int height);
+
+        /**
+         * @brief Libera un nodo reservado con `createNode`.
+         */
+        static void destroyNode(void* node);
+
+        /**
+         * @brief Sortea la altura de un nodo nuevo: 1 con probabilidad 3/4, 2 con 3/16, etc.
+         */
+        static int randomHeight();
+
+        /**
+         * @brief Descuenta `levels` niveles de `node` y lo retira si ya no queda ninguno.
+         */
+        static void releaseLevels(SkipNode* node, int levels);
+
+        /**
+         * @brief Busca `key` desenlazando los nodos marcados que encuentre en el camino.
+         *
+         * @effect En `preds[i]` y `succs[i]` deja, para cada nivel `i`, el último nodo con
+         *         llave menor que `key` y el siguiente a él.
+         *
+         * @return true si `succs[0]` tiene la llave `key` y no está marcado.
+         */
+        bool find(int key, SkipNode** preds, SkipNode** succs);
+
+        /**
+         * @brief Un recorrido de `find` desde la cabeza.
+         *
+         * @return FOUND o ABSENT, o RETRY si otro hilo cambió un enlace que había que
+         *         modificar y hay que empezar de nuevo.
+         */
+        Attempt attemptFind(int key, SkipNode** preds, SkipNode** succs);
+
+        /**
+         * @brief Enlaza los niveles superiores de un nodo recién insertado.
+         *
+         * @effect Si el nodo se marca mientras tanto, renuncia a los niveles que faltan y,
+         *         como pudo haber quedado enlazado en un nivel después de marcado, lo
+         *         busca otra vez para desenlazarlo.
+         */
+        void linkUpperLevels(SkipNode* node, SkipNode** preds, SkipNode** succs);
+
+        /**
+         * @brief Enlaza `node` en el nivel `level` entre `preds[level]` y `succs[level]`.
+         *
+         * @return false si el nodo se marcó o salió del nivel inferior antes de enlazarlo.
+         */
+        bool linkLevel(SkipNode* node, int level, SkipNode** preds, SkipNode** succs);
+
+    public:
+        /**
+         * @brief Constructs an empty skip list.
+         */
+        SkipListDict();
+
+        SkipListDict(const SkipListDict&) = delete;
+        SkipListDict& operator=(const SkipListDict&) = delete;
+
+        /**
+         * @brief Deletes every node still linked in the list.
+         *
+         * @require No other thread may be using the list.
+         */
+        ~SkipListDict();
+
+        /**
+         * @brief Inserta un elemento si no estaba, sin tomar candados.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en la lista sin escribir en memoria compartida.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en la lista, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Marca el nodo del elemento como eliminado y lo desenlaza de todos sus niveles.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Llama a `visit` con cada llave no marcada del nivel inferior, en orden.
+         *
+         * @effect Si otros hilos modifican la lista a la vez, puede ver o no las llaves que
+         *         cambian durante el recorrido, pero nunca una llave dos veces.
+         *
+         * @return true, porque la lista siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño y las llaves en orden con la altura de cada nodo.
+         *
+         * @require No other thread may be modifying the list.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes de los nodos enlazados en el nivel inferior y de la cabeza.
+         *
+         * @require No other thread may be modifying the list.
+         */
+        size_t memoryUsage() override;
+};
@@ -0,0 +1,219 @@
+#include "SplayTree.hpp"
+#include <sstream>
+#include <vector>
+#include "../Serialization/BufferedWriter.hpp"
+
+SplayTree::SplayTree()
+    : root(nullptr)
+    , size(0) {
+}
+
+SplayTree::~SplayTree() {
+    clear();
+}
+
+SplayTree::SplayNode* SplayTree::splay(SplayNode* node, int key) {
+    if (node == nullptr) {
+        return nullptr;
+    }
+
+    // header.right junta el árbol de las llaves menores y header.left el de las mayores
+    SplayNode header(0);
+    SplayNode* leftMax = &header;
+    SplayNode* rightMin = &header;
+    while (true) {
+        if (key < node->data) {
+            if (node->left == nullptr) {
+                break;
+            }
+            if (key < node->left->data) {
+                // Zig-zig: rotar a la derecha antes de cortar
+                SplayNode* child = node->left;
+                node->left = child->right;
+                child->right = node;
+                node = child;
+                if (node->left == nullptr) {
+                    break;
+                }
+            }
+            // El nodo y su lado derecho van al árbol de las mayores
+            rightMin->left = node;
+            rightMin = node;
+            node = node->left;
+        } else if (key > node->data) {
+            if (node->right == nullptr) {
+                break;
+            }
+            if (key > node->right->data) {
+                SplayNode* child = node->right;
+                node->right = child->left;
+                child->left = node;
+                node = child;
+                if (node->right == nullptr) {
+                    break;
+                }
+            }
+            leftMax->right = node;
+            leftMax = node;
+            node = node->right;
+        } else {
+            break;
+        }
+    }
+
+    // Armar: los hijos del nodo final cierran los dos árboles, que pasan a ser sus hijos
+    leftMax->right = node->left;
+    rightMin->left = node->right;
+    node->left = header.right;
+    node->right = header.left;
+    return node;
+}
+
+void SplayTree::insert(int element) {
+    if (root == nullptr) {
+        root = new SplayNode(element);
+        size++;
+        return;
+    }
+
+    root = splay(root, element);
+    if (root->data == element) {
+        return; // element already exists in the tree
+    }
+
+    SplayNode* node = new SplayNode(element);
+    if (element < root->data) {
+        node->left = root->left;
+        node->right = root;
+        root->left = nullptr;
+    } else {
+        node->right = root->right;
+        node->left = root;
+        root->right = nullptr;
+    }
+    root = node;
+    size++;
+}
+
+bool SplayTree::contains(int element) {
+    root = splay(root, element);
+    return root != nullptr && root->data == element;
+}
+
+void SplayTree::erase(int element) {
+    root = splay(root, element);
+    if (root == nullptr || root->data != element) {
+        return;
+    }
+
+    SplayNode* old = root;
+    if (root->left == nullptr) {
+        root = root->right;
+    } else {
+        // Todas las llaves de la izquierda son menores: el splay sube su máximo
+        root = splay(root->left, element);
+        root->right = old->right;
+    }
+    delete old;
+    size--;
+}
+
+void SplayTree::clear() {
+    SplayNode* node = root;
+    while (node != nullptr) {
+        if (node->left != nullptr) {
+            SplayNode* child = node->left;
+            node->left = child->right;
+            child->right = node;
+            node = child;
+        } else {
+            SplayNode* next = node->right;
+            delete node;
+            node = next;
+        }
+    }
+    root = nullptr;
+    size = 0;
+}
+
+size_t SplayTree::count() const {
+    return size;
+}
+
+bool SplayTree::forEachElement(const std::function<void(int)>& visit) {
+    std::vector<const SplayNode*> pending;
+    if (root != nullptr) {
+        pending.push_back(root);
+    }
+    while (!pending.empty()) {
+        const SplayNode* node = pending.back();
+        pending.pop_back();
+        visit(node->data);
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
+        }
+    }
+    return true;
+}
+
+std::string SplayTree::toString() {
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer);
+    }
+    return stream.str();
+}
+
+void SplayTree::writeTo(BufferedWriter& writer) const {
+    writer.write("Size: ");
+    writer.write(size);
+    writer.write("\nElements:\n");
+
+    // Preorden con pila: una cadena larga no agota la pila de llamadas
+    std::vector<const SplayNode*> pending;
+    if (root != nullptr) {
+        pending.push_back(root);
+    }
+    while (!pending.empty()) {
+        const SplayNode* node = pending.back();
+        pending.pop_back();
+
+        writer.write("Node: ");
+        writer.write(node->data);
+        writer.write("-->");
+        if (node->left || node->right) {
+            writer.write("  Children: ");
+            if (node->left) {
+                writer.write("Left: ");
+                writer.write(node->left->data);
+            } else {
+                writer.write("Left: None");
+            }
+            writer.write(", ");
+            if (node->right) {
+                writer.write("Right: ");
+                writer.write(node->right->data);
+            } else {
+                writer.write("Right: None");
+            }
+            writer.write("\n");
+        } else {
+            writer.write("  No children\n");
+        }
+
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
+        }
+    }
+}
+
+size_t SplayTree::memoryUsage() {
+    return size * sizeof(SplayNode);
+}
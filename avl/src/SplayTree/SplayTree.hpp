@@ -0,0 +1,132 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include "../Dict/Dict.h"
+
+class BufferedWriter;
+
+/**
+ * @class SplayTree
+ * @brief A self-adjusting binary search tree that moves every key it touches to the root.
+ *
+ * Every operation splays the tree top-down (Sleator and Tarjan): while descending
+ * towards the key it cuts the visited nodes into a left tree of smaller keys and a right
+ * tree of larger keys, rotating every two steps in the same direction, and finally hangs
+ * both trees under the last node reached. No parent pointers and no recursion are
+ * needed, and the cost is amortized O(log n) per operation.
+ *
+ * Nothing keeps the tree balanced, but keys used often stay near the root: with a
+ * skewed workload, where a few hot keys take most of the accesses, a search for one of
+ * them costs a few steps instead of the ~log n of a balanced tree.
+ */
+class SplayTree : public Dict {
+    protected:
+        /**
+         * @struct SplayNode
+         * @brief A node with only its key and its two children.
+         */
+        struct SplayNode {
+            SplayNode(int data)
+            : data(data)
+            , left(nullptr)
+            , right(nullptr) {
+            };
+            int data;
+            SplayNode* left;
+            SplayNode* right;
+        };
+
+        SplayNode* root; /// Pointer to the root node of the tree.
+        int size;        /// The number of nodes in the tree.
+
+        /**
+         * @brief Trae a la raíz de un subárbol el nodo de `key`, o el último nodo visitado al buscarla.
+         *
+         * @effect Si `key` no está, la nueva raíz es su predecesor o su sucesor en el subárbol.
+         *
+         * @param node La raíz del subárbol, que puede ser nula.
+         * @return La nueva raíz del subárbol.
+         */
+        static SplayNode* splay(SplayNode* node, int key);
+
+        /**
+         * @brief Escribe el tamaño del árbol y sus nodos en preorden con una pila explícita.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+    public:
+        /**
+         * @brief Constructs an empty tree.
+         */
+        SplayTree();
+
+        SplayTree(const SplayTree&) = delete;
+        SplayTree& operator=(const SplayTree&) = delete;
+
+        /**
+         * @brief Deletes every node of the tree.
+         */
+        ~SplayTree();
+
+        /**
+         * @brief Removes every element from the tree.
+         *
+         * @effect Rota hacia la derecha cada hijo izquierdo que encuentra y borra los nodos
+         *         que quedan sin él, así que no usa recursión ni pila aunque el árbol sea una
+         *         cadena de n nodos.
+         */
+        void clear();
+
+        /**
+         * @brief Inserta un elemento y lo deja en la raíz.
+         *
+         * @effect Hace splay con el elemento; si no estaba, el nodo nuevo se vuelve la raíz y
+         *         la raíz anterior, con el lado que le corresponde, pasa a ser su hijo.
+         *
+         * @param element El valor del elemento a insertar.
+         */
+        void insert(int element) override;
+
+        /**
+         * @brief Verifica si un elemento está en el árbol.
+         *
+         * @effect Hace splay con el elemento, así que cambia la forma del árbol aunque no
+         *         cambie sus llaves.
+         *
+         * @param element El valor a buscar.
+         * @return true si el elemento está en el árbol, false en caso contrario.
+         */
+        bool contains(int element) override;
+
+        /**
+         * @brief Elimina un elemento si está presente.
+         *
+         * @effect Hace splay con el elemento y, si quedó en la raíz, la reemplaza por el
+         *         máximo de su subárbol izquierdo, que queda sin hijo derecho.
+         *
+         * @param element El valor del elemento a eliminar.
+         */
+        void erase(int element) override;
+
+        /**
+         * @brief Devuelve la cantidad de llaves del árbol.
+         */
+        size_t count() const;
+
+        /**
+         * @brief Llama a `visit` con cada llave del árbol, en preorden y sin hacer splay.
+         *
+         * @return true, porque el árbol siempre puede listar sus llaves.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve el tamaño del árbol y sus nodos en preorden con sus hijos.
+         */
+        std::string toString() override;
+
+        /**
+         * @brief Devuelve los bytes ocupados por los nodos del árbol.
+         */
+        size_t memoryUsage() override;
+};
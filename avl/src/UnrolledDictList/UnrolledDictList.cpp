@@ -0,0 +1,228 @@
+#include "UnrolledDictList.hpp"
+
+#include <algorithm>
+#include <climits>
+
+#include "../Simd/KeySearch.hpp"
+
+UnrolledDictList::Block::Block(bool anchor)
+    : count(0), anchor(anchor), next(nullptr) {
+  std::fill(keys, keys + BLOCK_KEYS, INT_MAX);
+}
+
+UnrolledDictList::UnrolledDictList()
+    : head(new Block(true)), blockCount(1) {
+  anchorKeys.push_back(INT_MIN);
+  anchors.push_back(head);
+  segmentBlocks.push_back(1);
+}
+
+size_t UnrolledDictList::anchorFor(int element) const {
+  // anchorKeys[0] is INT_MIN, so there is always an anchor at or before element
+  return std::upper_bound(anchorKeys.begin(), anchorKeys.end(), element)
+      - anchorKeys.begin() - 1;
+}
+
+UnrolledDictList::Block* UnrolledDictList::findBlock(int element,
+    size_t anchor, Block*& previous) const {
+  Block* block = anchors[anchor];
+  previous = nullptr;
+  // Blocks that are not anchors are never empty, so keys[0] is a real key
+  while (block->next != nullptr && !block->next->anchor
+      && block->next->keys[0] <= element) {
+    previous = block;
+    block = block->next;
+  }
+  return block;
+}
+
+int UnrolledDictList::lowerBound(const Block* block, int element) {
+  return static_cast<int>(simd::countLess<BLOCK_KEYS>(block->keys, element));
+}
+
+void UnrolledDictList::insertKey(Block* block, int position, int element) {
+  std::copy_backward(block->keys + position, block->keys + block->count,
+      block->keys + block->count + 1);
+  block->keys[position] = element;
+  block->count++;
+}
+
+void UnrolledDictList::removeKey(Block* block, int position) {
+  std::copy(block->keys + position + 1, block->keys + block->count,
+      block->keys + position);
+  block->count--;
+  block->keys[block->count] = INT_MAX;
+}
+
+UnrolledDictList::Block* UnrolledDictList::splitBlock(Block* block) {
+  const int leftCount = BLOCK_KEYS / 2;
+  Block* right = new Block(false);
+  ++blockCount;
+  std::copy(block->keys + leftCount, block->keys + block->count, right->keys);
+  std::fill(block->keys + leftCount, block->keys + block->count, INT_MAX);
+  right->count = block->count - leftCount;
+  block->count = leftCount;
+
+  right->next = block->next;
+  block->next = right;
+  return right;
+}
+
+void UnrolledDictList::splitSegment(size_t anchor) {
+  const int leftBlocks = segmentBlocks[anchor] / 2;
+  Block* middle = anchors[anchor];
+  for (int i = 0; i < leftBlocks; ++i) {
+    middle = middle->next;
+  }
+
+  // The middle block is not empty, so its first key bounds its segment
+  middle->anchor = true;
+  anchorKeys.insert(anchorKeys.begin() + anchor + 1, middle->keys[0]);
+  anchors.insert(anchors.begin() + anchor + 1, middle);
+  segmentBlocks.insert(segmentBlocks.begin() + anchor + 1,
+      segmentBlocks[anchor] - leftBlocks);
+  segmentBlocks[anchor] = leftBlocks;
+}
+
+void UnrolledDictList::dropAnchor(size_t anchor) {
+  // The last block of the previous segment is at most MAX_SEGMENT links away
+  Block* last = anchors[anchor - 1];
+  for (int i = 1; i < segmentBlocks[anchor - 1]; ++i) {
+    last = last->next;
+  }
+  Block* block = anchors[anchor];
+  last->next = block->next;
+  delete block;
+  --blockCount;
+
+  segmentBlocks[anchor - 1] += segmentBlocks[anchor] - 1;
+  anchorKeys.erase(anchorKeys.begin() + anchor);
+  anchors.erase(anchors.begin() + anchor);
+  segmentBlocks.erase(segmentBlocks.begin() + anchor);
+  if (segmentBlocks[anchor - 1] > MAX_SEGMENT) {
+    splitSegment(anchor - 1);
+  }
+}
+
+void UnrolledDictList::insert(int element) {
+  size_t anchor = anchorFor(element);
+  Block* previous;
+  Block* block = findBlock(element, anchor, previous);
+
+  int position = lowerBound(block, element);
+  if (position < block->count && block->keys[position] == element) {
+    return;  // element already exists in the list
+  }
+
+  if (block->count < BLOCK_KEYS) {
+    insertKey(block, position, element);
+    return;
+  }
+
+  Block* right = splitBlock(block);
+  if (position > block->count) {
+    insertKey(right, position - block->count, element);
+  } else {
+    insertKey(block, position, element);
+  }
+  if (++segmentBlocks[anchor] > MAX_SEGMENT) {
+    splitSegment(anchor);
+  }
+}
+
+bool UnrolledDictList::contains(int element) {
+  Block* previous;
+  const Block* block = findBlock(element, anchorFor(element), previous);
+  int position = lowerBound(block, element);
+  return position < block->count && block->keys[position] == element;
+}
+
+void UnrolledDictList::erase(int element) {
+  size_t anchor = anchorFor(element);
+  Block* previous;
+  Block* block = findBlock(element, anchor, previous);
+
+  int position = lowerBound(block, element);
+  if (position >= block->count || block->keys[position] != element) {
+    return;
+  }
+  removeKey(block, position);
+
+  if (block->count == 0 && block->anchor) {
+    if (anchor > 0) {
+      dropAnchor(anchor);
+    }
+    return;
+  }
+
+  // An empty block that is not an anchor always has a block before it
+  if (block->count == 0) {
+    previous->next = block->next;
+    delete block;
+    --blockCount;
+    --segmentBlocks[anchor];
+    return;
+  }
+
+  Block* next = block->next;
+  if (block->count < MERGE_KEYS && next != nullptr && !next->anchor
+      && block->count + next->count <= BLOCK_KEYS / 2) {
+    std::copy(next->keys, next->keys + next->count,
+        block->keys + block->count);
+    block->count += next->count;
+    block->next = next->next;
+    delete next;
+    --blockCount;
+    --segmentBlocks[anchor];
+  }
+}
+
+bool UnrolledDictList::forEachElement(const std::function<void(int)>& visit) {
+  for (Block* block = head; block != nullptr; block = block->next) {
+    for (int i = 0; i < block->count; ++i) {
+      visit(block->keys[i]);
+    }
+  }
+  return true;
+}
+
+std::string UnrolledDictList::toString() {
+  std::string result = "";
+
+  for (Block* block = head; block != nullptr; block = block->next) {
+    if (block->count == 0) {
+      continue;
+    }
+    result += "[";
+    for (int i = 0; i < block->count; ++i) {
+      if (i > 0) {
+        result += " ";
+      }
+      result += std::to_string(block->keys[i]);
+    }
+    result += "] --> ";
+  }
+
+  if (result.empty()) {
+    return "There are no elements in the dictionary\n";
+  }
+  result += "nullptr\n";
+
+  return result;
+}
+
+size_t UnrolledDictList::memoryUsage() {
+  return blockCount * sizeof(Block)
+      + anchorKeys.capacity() * sizeof(int)
+      + anchors.capacity() * sizeof(Block*)
+      + segmentBlocks.capacity() * sizeof(int);
+}
+
+UnrolledDictList::~UnrolledDictList() {
+  Block* current = head;
+  while (current != nullptr) {
+    Block* next = current->next;
+    delete current;
+    current = next;
+  }
+}
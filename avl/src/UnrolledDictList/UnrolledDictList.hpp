@@ -0,0 +1,172 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "../Dict/Dict.h"
+
+// A sorted list whose nodes are blocks of keys instead of single keys. Every
+// block holds up to 16 sorted keys, padded with INT_MAX, that fill one cache
+// line and are searched with vector compares (see simd::countLess); with the
+// count, the anchor flag and the link each block takes 128 bytes. A sparse
+// index of "anchor" blocks, sorted by a lower bound of their keys, lets a
+// search jump close to its block with a binary search and then walk only a
+// few links.
+//
+// Each anchor counts the blocks of its segment, up to the next anchor, and
+// a segment that grows past MAX_SEGMENT blocks is cut in two by promoting
+// its middle block, so no search walks more than MAX_SEGMENT links. An
+// anchor that runs out of keys leaves the index and its segment joins the
+// one before it, so the index and the blocks follow the live keys instead
+// of every key ever inserted. Only the head, the anchor for INT_MIN, stays
+// when it is empty.
+class UnrolledDictList : public Dict {
+ private:
+  // Keys per block, one cache line of keys
+  static const int BLOCK_KEYS = 16;
+  // A block with fewer keys than this tries to absorb the next one
+  static const int MERGE_KEYS = BLOCK_KEYS / 4;
+  // Blocks of a segment, from its anchor to the next one, before it is cut
+  static const int MAX_SEGMENT = 16;
+
+  // A sorted run of keys, linked to the next run
+  struct alignas(64) Block {
+    int keys[BLOCK_KEYS];  // Sorted keys, padded with INT_MAX
+    int count;             // Number of keys in use
+    bool anchor;           // Whether the block is in the index
+    Block* next;           // The block with the next larger keys
+
+    explicit Block(bool anchor);
+  };
+
+  Block* head;                      // First block, the anchor for INT_MIN
+  std::vector<int> anchorKeys;      // No key before anchors[i] reaches anchorKeys[i]
+  std::vector<Block*> anchors;      // Anchor blocks in list order
+  std::vector<int> segmentBlocks;   // Blocks from anchors[i] to the next anchor
+  size_t blockCount;                // Number of blocks, for memoryUsage
+
+  // Find the last anchor whose lower bound is not greater than element
+  /**
+   * Requires: An integer element.
+   * Effects: Binary searches the index and returns the position of the anchor.
+   * Modifies: Nothing.
+   */
+  size_t anchorFor(int element) const;
+
+  // Find the block where element is or should be inserted
+  /**
+   * Requires: The position of the anchor returned by anchorFor(element).
+   * Effects: Walks from the anchor while the next block is not an anchor and
+   *          starts at or before element. Stores in previous the block before
+   *          the one returned, or nullptr for the anchor itself.
+   * Modifies: previous.
+   */
+  Block* findBlock(int element, size_t anchor, Block*& previous) const;
+
+  // Position of the first key of the block not less than element
+  static int lowerBound(const Block* block, int element);
+
+  // Shift the keys from position on and store element there
+  static void insertKey(Block* block, int position, int element);
+
+  // Remove the key at position and pad the freed slot with INT_MAX
+  static void removeKey(Block* block, int position);
+
+  // Move the upper half of a full block to a new block linked after it
+  Block* splitBlock(Block* block);
+
+  // Cut a segment that grew too long by promoting its middle block
+  /**
+   * Requires: The position of an anchor whose segment has more than
+   *           MAX_SEGMENT blocks.
+   * Effects: Walks to the middle of the segment and adds that block to the
+   *          index, right after the anchor.
+   * Modifies: The index.
+   */
+  void splitSegment(size_t anchor);
+
+  // Drop an empty anchor and join its segment to the one before it
+  /**
+   * Requires: The position of an anchor, other than the head, whose block
+   *           has no keys.
+   * Effects: Unlinks and frees the anchor block, removes it from the index
+   *          and adds the rest of its segment to the previous anchor's,
+   *          cutting the joined segment if it gets too long.
+   * Modifies: The list and the index.
+   */
+  void dropAnchor(size_t anchor);
+
+ public:
+  // Constructor
+  /**
+   * Requires: Nothing.
+   * Effects: Initializes a list with one empty anchor block.
+   * Modifies: The head and the index.
+   */
+  UnrolledDictList();
+
+  UnrolledDictList(const UnrolledDictList&) = delete;
+  UnrolledDictList& operator=(const UnrolledDictList&) = delete;
+
+  // Insert a new element/key
+  /**
+   * Requires: An integer element.
+   * Effects: Finds the block of the element in a single pass and inserts it
+   *          there if it is missing, splitting the block when it is full.
+   * Modifies: The list, and the index when a segment gets too long.
+   */
+  void insert(int element) override;
+
+  // Determine if an element exists
+  /**
+   * Requires: An integer element/key.
+   * Effects: Returns true if the element is in the list.
+   * Modifies: Nothing.
+   */
+  bool contains(int element) override;
+
+  // Remove an element
+  /**
+   * Requires: An integer element/key.
+   * Effects: Removes the element if it exists. A block left empty is freed,
+   *          leaving the index if it is an anchor other than the head, and a
+   *          nearly empty block absorbs the next one when both fit in half a
+   *          block.
+   * Modifies: The list and the index.
+   */
+  void erase(int element) override;
+
+  // Visit every element in ascending order
+  /**
+   * Requires: A function that does not modify the list.
+   * Effects: Walks the blocks calling visit with every key in ascending
+   *          order, and returns true.
+   * Modifies: Nothing.
+   */
+  bool forEachElement(const std::function<void(int)>& visit) override;
+
+  // Return a string representation of the dictionary
+  /**
+   * Requires: Nothing.
+   * Effects: Returns the keys of every block in order, one block per bracket.
+   * Modifies: Nothing.
+   */
+  std::string toString() override;
+
+  // Return the bytes used by the blocks and the index
+  /**
+   * Requires: Nothing.
+   * Effects: Returns the memory held by the blocks and the anchor vectors.
+   * Modifies: Nothing.
+   */
+  size_t memoryUsage() override;
+
+  // Destructor
+  /**
+   * Requires: Nothing.
+   * Effects: Frees every block of the list.
+   * Modifies: The list, by deallocating all blocks.
+   */
+  ~UnrolledDictList();
+};
@@ -1,10 +1,126 @@
 #include "Bin.hpp"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
+#include <vector>
+#include "../Dict/Batch.hpp"
+#include "../Serialization/BufferedWriter.hpp"
+#include "../Serialization/Snapshot.hpp"
+
+uint32_t Bin::nextPriority() {
+    priorityState ^= priorityState << 13;
+    priorityState ^= priorityState >> 7;
+    priorityState ^= priorityState << 17;
+    return static_cast<uint32_t>(priorityState >> 32);
+}
+
+void Bin::split(Node* node, int key, Node** less, Node** notLess) {
+    // Cada nodo visitado cuelga del borde derecho de `less` o del izquierdo de `notLess`
+    while (node != nullptr) {
+        if (node->data < key) {
+            *less = node;
+            less = &node->right;
+            node = node->right;
+        } else {
+            *notLess = node;
+            notLess = &node->left;
+            node = node->left;
+        }
+    }
+    *less = nullptr;
+    *notLess = nullptr;
+}
+
+Bin::Node* Bin::merge(Node* left, Node* right) {
+    Node* result = nullptr;
+    Node** link = &result;
+    // Bajar por el borde derecho de `left` y el izquierdo de `right` según las prioridades
+    while (left != nullptr && right != nullptr) {
+        if (left->priority > right->priority) {
+            *link = left;
+            link = &left->right;
+            left = left->right;
+        } else {
+            *link = right;
+            link = &right->left;
+            right = right->left;
+        }
+    }
+    *link = (left != nullptr) ? left : right;
+    return result;
+}
+
+Bin::Node* Bin::unite(Node* first, Node* second) {
+    if (first == nullptr) {
+        return second;
+    }
+    if (second == nullptr) {
+        return first;
+    }
+    if (first->priority < second->priority) {
+        std::swap(first, second);
+    }
+
+    Node* less;
+    Node* notLess;
+    split(second, first->data, &less, &notLess);
+
+    // La llave de `first` solo puede repetirse como la mínima de `notLess`
+    Node** link = &notLess;
+    while (*link != nullptr && (*link)->left != nullptr) {
+        link = &(*link)->left;
+    }
+    if (*link != nullptr && (*link)->data == first->data) {
+        Node* duplicate = *link;
+        *link = duplicate->right;
+        delete duplicate;
+        size--;
+    }
+
+    first->left = unite(first->left, less);
+    first->right = unite(first->right, notLess);
+    return first;
+}
+
+Bin::Node* Bin::buildTreap(const int* elements, size_t count) {
+    // El borde derecho del árbol cartesiano construido hasta ahora
+    std::vector<Node*> spine;
+    for (size_t i = 0; i < count; ++i) {
+        Node* node = new Node(elements[i], nextPriority());
+        Node* last = nullptr;
+        while (!spine.empty() && spine.back()->priority < node->priority) {
+            last = spine.back();
+            spine.pop_back();
+        }
+        node->left = last;
+        if (!spine.empty()) {
+            spine.back()->right = node;
+        }
+        spine.push_back(node);
+    }
+    return spine.empty() ? nullptr : spine.front();
+}
 
 void Bin::insert(int element) {
+    if (treap) {
+        if (contains(element)) {
+            return; // element already exists in the tree
+        }
+        Node* node = new Node(element, nextPriority());
+        Node** link = &this->root;
+        while (*link != nullptr && (*link)->priority > node->priority) {
+            link = (element < (*link)->data) ? &(*link)->left : &(*link)->right;
+        }
+        split(*link, element, &node->left, &node->right);
+        *link = node;
+        size++;
+        return;
+    }
+
     // if root is null, create a new node and set it as root
     if (this->root == nullptr) {
         this->root = new Node(element);
+        size++;
         return;
     } else {
         Node* current = this->root;
@@ -51,6 +167,17 @@ bool Bin::contains(int element) {
 }
 
 void Bin::erase(int element) {
+    if (treap) {
+        Node** link = &this->root;
+        while (*link != nullptr && (*link)->data != element) {
+            link = (element < (*link)->data) ? &(*link)->left : &(*link)->right;
+        }
+        if (*link != nullptr) {
+            removeAt(link);
+        }
+        return;
+    }
+
     Node* current = this->root;
     Node* parent = nullptr;
 
@@ -110,59 +237,321 @@ void Bin::erase(int element) {
     size--;
 }
 
+Bin::Node* Bin::buildSubtree(const int* elements, size_t count) {
+    if (count == 0) {
+        return nullptr;
+    }
+
+    size_t middle = count / 2;
+    Node* node = new Node(elements[middle]);
+    node->left = buildSubtree(elements, middle);
+    node->right = buildSubtree(elements + middle + 1, count - middle - 1);
+    return node;
+}
+
+void Bin::removeAt(Node** link) {
+    Node* current = *link;
+
+    if (treap) {
+        *link = merge(current->left, current->right);
+        delete current;
+        size--;
+        return;
+    }
+
+    // if the node has two children, move the inorder successor up
+    if (current->left != nullptr && current->right != nullptr) {
+        Node** successorLink = &current->right;
+        while ((*successorLink)->left != nullptr) {
+            successorLink = &(*successorLink)->left;
+        }
+        Node* successor = *successorLink;
+        current->data = successor->data;
+        *successorLink = successor->right;
+        delete successor;
+    } else {
+        *link = (current->left != nullptr) ? current->left : current->right;
+        delete current;
+    }
+    size--;
+}
+
+void Bin::insertMany(const int* elements, size_t count) {
+    std::vector<int> keys = batch::sortedUnique(elements, count);
+
+    if (treap) {
+        // `unite` descuenta las llaves que ya estaban
+        size += static_cast<int>(keys.size());
+        this->root = unite(this->root, buildTreap(keys.data(), keys.size()));
+        return;
+    }
+
+    // Each frame holds a link and the range of the batch that belongs below it
+    struct Frame {
+        Node** link;
+        size_t low;
+        size_t high;
+    };
+    std::vector<Frame> pending;
+    if (!keys.empty()) {
+        pending.push_back({&this->root, 0, keys.size()});
+    }
+
+    while (!pending.empty()) {
+        Frame frame = pending.back();
+        pending.pop_back();
+        Node* node = *frame.link;
+
+        // the rest of the range becomes a balanced subtree at the empty link
+        if (node == nullptr) {
+            *frame.link = buildSubtree(keys.data() + frame.low, frame.high - frame.low);
+            size += static_cast<int>(frame.high - frame.low);
+            continue;
+        }
+
+        size_t middle = std::lower_bound(keys.begin() + frame.low,
+            keys.begin() + frame.high, node->data) - keys.begin();
+        size_t greater = middle;
+        if (greater < frame.high && keys[greater] == node->data) {
+            ++greater; // element already exists in the tree
+        }
+
+        if (frame.low < middle) {
+            pending.push_back({&node->left, frame.low, middle});
+        }
+        if (greater < frame.high) {
+            pending.push_back({&node->right, greater, frame.high});
+        }
+    }
+}
+
+void Bin::containsMany(const int* elements, size_t count, std::vector<bool>& found) {
+    std::vector<std::pair<int, size_t>> entries = batch::sortedPositions(elements, count);
+    found.assign(count, false);
+
+    struct Frame {
+        Node* node;
+        size_t low;
+        size_t high;
+    };
+    std::vector<Frame> pending;
+    if (!entries.empty()) {
+        pending.push_back({this->root, 0, entries.size()});
+    }
+
+    while (!pending.empty()) {
+        Frame frame = pending.back();
+        pending.pop_back();
+        if (frame.node == nullptr) {
+            continue; // the elements of this range are not in the tree
+        }
+
+        auto range = std::equal_range(entries.begin() + frame.low,
+            entries.begin() + frame.high, frame.node->data, batch::ElementLess());
+        for (auto entry = range.first; entry != range.second; ++entry) {
+            found[entry->second] = true;
+        }
+
+        size_t middle = range.first - entries.begin();
+        size_t greater = range.second - entries.begin();
+        if (frame.low < middle) {
+            pending.push_back({frame.node->left, frame.low, middle});
+        }
+        if (greater < frame.high) {
+            pending.push_back({frame.node->right, greater, frame.high});
+        }
+    }
+}
+
+void Bin::eraseMany(const int* elements, size_t count) {
+    std::vector<int> keys = batch::sortedUnique(elements, count);
+
+    struct Frame {
+        Node** link;
+        size_t low;
+        size_t high;
+    };
+    std::vector<Frame> pending;
+    if (!keys.empty()) {
+        pending.push_back({&this->root, 0, keys.size()});
+    }
+
+    while (!pending.empty()) {
+        Frame frame = pending.back();
+        pending.pop_back();
+
+        while (*frame.link != nullptr) {
+            Node* node = *frame.link;
+            size_t middle = std::lower_bound(keys.begin() + frame.low,
+                keys.begin() + frame.high, node->data) - keys.begin();
+
+            // remove the node and look again at whatever took its place
+            if (middle < frame.high && keys[middle] == node->data) {
+                removeAt(frame.link);
+                continue;
+            }
+
+            if (frame.low < middle) {
+                pending.push_back({&node->left, frame.low, middle});
+            }
+            if (middle < frame.high) {
+                pending.push_back({&node->right, middle, frame.high});
+            }
+            break;
+        }
+    }
+}
+
+bool Bin::forEachElement(const std::function<void(int)>& visit) {
+    std::vector<const Node*> pending;
+    if (root != nullptr) {
+        pending.push_back(root);
+    }
+    while (!pending.empty()) {
+        const Node* node = pending.back();
+        pending.pop_back();
+        visit(node->data);
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
+        }
+    }
+    return true;
+}
+
 std::string Bin::toString() {
-    std::string result;
-    result += "Size: " + std::to_string(size) + "\n";
-    result += "Elements:\n";
-    result += toString(this->root);
-    return result;
+    std::ostringstream stream;
+    writeTo(stream);
+    return stream.str();
+}
+
+bool Bin::writeTo(std::ostream& stream) {
+    BufferedWriter writer(stream);
+    writeTo(writer);
+    return writer.flush();
+}
+
+bool Bin::writeTo(FILE* file) {
+    BufferedWriter writer(file);
+    writeTo(writer);
+    return writer.flush();
 }
 
 std::string Bin::toString(Node* node) {
-     if (node == nullptr) {
-        return "";
+    std::ostringstream stream;
+    {
+        BufferedWriter writer(stream);
+        writeTo(writer, node);
     }
+    return stream.str();
+}
+
+void Bin::writeTo(BufferedWriter& writer) const {
+    writer.write("Size: ");
+    writer.write(size);
+    writer.write("\nElements:\n");
+    writeTo(writer, root);
+}
 
-    std::string result;
+void Bin::writeTo(BufferedWriter& writer, const Node* node) const {
+    // Preorden con pila: en un árbol degenerado la pila no pasa de un nodo
+    std::vector<const Node*> pending;
+    if (node != nullptr) {
+        pending.push_back(node);
+    }
+    while (!pending.empty()) {
+        const Node* node = pending.back();
+        pending.pop_back();
 
-    // Agregar espacios de indentación y la información del nodo
-    result += "Node: " + std::to_string(node->data) + "-->";
-    // Mostrar hijos
-    if (node->left || node->right) {
-        result += "  Children: ";
-        if (node->left) {
-            result += "Left: " + std::to_string(node->left->data);
+        writer.write("Node: ");
+        writer.write(node->data);
+        writer.write("-->");
+        // Mostrar hijos
+        if (node->left || node->right) {
+            writer.write("  Children: ");
+            if (node->left) {
+                writer.write("Left: ");
+                writer.write(node->left->data);
+            } else {
+                writer.write("Left: None");
+            }
+            writer.write(", ");
+            if (node->right) {
+                writer.write("Right: ");
+                writer.write(node->right->data);
+            } else {
+                writer.write("Right: None");
+            }
+            writer.write("\n");
         } else {
-            result += "Left: None";
+            writer.write("  No children\n");
         }
-        result += ", ";
-        if (node->right) {
-            result += "Right: " + std::to_string(node->right->data);
-        } else {
-            result += "Right: None";
+
+        if (node->right != nullptr) {
+            pending.push_back(node->right);
+        }
+        if (node->left != nullptr) {
+            pending.push_back(node->left);
         }
-        result += "\n";
-    } else {
-        result += "  No children\n";
     }
+}
 
-    // Concatenar la información de los hijos de manera recursiva
-    result += toString(node->left);  // Aumentar indentación para el hijo izquierdo
-    result += toString(node->right); // Aumentar indentación para el hijo derecho
-
-    return result;
-};
+bool Bin::saveSnapshot(const char* path) {
+    FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    bool written;
+    {
+        SnapshotWriter snapshot(file);
+        // Recorrido en orden con pila: bajar por la izquierda y luego pasar a la derecha
+        std::vector<const Node*> pending;
+        const Node* node = root;
+        while (node != nullptr || !pending.empty()) {
+            while (node != nullptr) {
+                pending.push_back(node);
+                node = node->left;
+            }
+            node = pending.back();
+            pending.pop_back();
+            snapshot.add(node->data);
+            node = node->right;
+        }
+        written = snapshot.finish();
+    }
+    return std::fclose(file) == 0 && written;
+}
 
-void Bin::clear(Node* node) {
-    // Si el nodo es nulo, no hacer nada
-    if (node == nullptr) {
-        return;
+void Bin::loadSnapshot(const char* path) {
+    MappedSnapshot snapshot(path);
+    clear(root);
+    if (treap) {
+        root = buildTreap(snapshot.keys(), snapshot.count());
+    } else {
+        root = buildSubtree(snapshot.keys(), snapshot.count());
     }
+    size = static_cast<int>(snapshot.count());
+}
 
-    // Llamar recursivamente a la función para los hijos del nodo
-    this->clear(node->left);
-    this->clear(node->right);
+size_t Bin::memoryUsage() {
+    return size * sizeof(Node);
+}
 
-    // Eliminar el nodo
-    delete node;
+void Bin::clear(Node* node) {
+    while (node != nullptr) {
+        if (node->left != nullptr) {
+            // Rotar a la derecha: el hijo izquierdo sube y el nodo queda a su derecha
+            Node* child = node->left;
+            node->left = child->right;
+            child->right = node;
+            node = child;
+        } else {
+            // Sin hijo izquierdo, el nodo se borra y se sigue por la derecha
+            Node* next = node->right;
+            delete node;
+            node = next;
+        }
+    }
 }
@@ -1,7 +1,12 @@
 #pragma once
 #include "../Dict/Dict.h"
+#include <cstdint>
+#include <cstdio>
+#include <iosfwd>
 #include <string>
 
+class BufferedWriter;
+
 /**
  * @class Bin
  * @brief A class representing an binary tree.
@@ -9,6 +14,11 @@
  * The Tree class provides basic operations for a binary tree, including insertion,
  * search, and deletion of elements. It maintains a root node and keeps track of the
  * size of the tree.
+ *
+ * With the `TREAP` option every node also gets a random priority and the tree is kept
+ * as a heap on the priorities, which makes its shape that of a tree built from the keys
+ * in random order whatever the order they really arrive in: the expected depth is
+ * O(log n) even for sorted input, without storing heights or rebalancing.
  * 
  * @tparam int The type of data stored in the tree nodes.
  */
@@ -28,31 +38,138 @@ class Bin : public Dict {
          * 
          * @var Node::right
          * Pointer to the right child node.
+         *
+         * @var Node::priority
+         * Random priority used by the `TREAP` option; it takes the padding after `data`.
          */
         struct Node {
-            Node(int data)
+            Node(int data, uint32_t priority = 0)
             : data(data)
+            , priority(priority)
             , left(nullptr)
             , right(nullptr) {
             };
             int data;
+            uint32_t priority;
             Node* left;
             Node* right;
         };
         Node* root; /// Pointer to the root node of the tree.
         int size;  /// The number of nodes in the tree.
+        bool treap; /// Whether the tree is kept as a treap.
+        uint64_t priorityState; /// Estado de xorshift para las prioridades del treap.
+
+        /**
+         * @brief Devuelve una prioridad al azar para un nodo nuevo del treap.
+         */
+        uint32_t nextPriority();
+
+        /**
+         * @brief Parte un treap en las llaves menores que `key` y las mayores o iguales.
+         *
+         * @effect Baja una sola vez por el camino de `key` sin recursión; los nodos
+         *         conservan sus prioridades, así que ambas partes siguen siendo treaps.
+         *
+         * @param node La raíz del treap a partir, que queda repartido entre las dos partes.
+         * @param less Recibe la raíz del treap de las llaves menores que `key`.
+         * @param notLess Recibe la raíz del treap de las llaves mayores o iguales.
+         */
+        static void split(Node* node, int key, Node** less, Node** notLess);
+
+        /**
+         * @brief Une dos treaps cuando todas las llaves de `left` son menores que las de `right`.
+         *
+         * @return La raíz del treap unido.
+         */
+        static Node* merge(Node* left, Node* right);
+
+        /**
+         * @brief Une dos treaps con llaves cualesquiera, descartando las repetidas.
+         *
+         * @effect La raíz de mayor prioridad parte al otro treap por su llave y cada mitad se
+         *         une recursivamente con el hijo que le corresponde; la profundidad esperada
+         *         de la recursión es O(log n). Cada llave repetida se borra y disminuye `size`.
+         *
+         * @return La raíz del treap unido.
+         */
+        Node* unite(Node* first, Node* second);
+
+        /**
+         * @brief Construye un treap en O(n) a partir de elementos ordenados.
+         *
+         * @effect Sortea una prioridad por elemento y arma el árbol cartesiano con una pila
+         *         del borde derecho.
+         *
+         * @require `elements` debe estar en orden estrictamente ascendente.
+         *
+         * @return La raíz del treap, o nullptr si `count` es cero.
+         */
+        Node* buildTreap(const int* elements, size_t count);
+
+        /**
+         * @brief Construye un subárbol balanceado a partir de elementos ordenados.
+         *
+         * @require `elements` debe estar en orden estrictamente ascendente.
+         *
+         * @param elements Los elementos del subárbol.
+         * @param count La cantidad de elementos.
+         * @return La raíz del subárbol, o nullptr si `count` es cero.
+         */
+        Node* buildSubtree(const int* elements, size_t count);
+
+        /**
+         * @brief Elimina el nodo al que apunta `link`, reemplazándolo por su sucesor si tiene dos hijos.
+         *
+         * @require `*link` no debe ser nulo.
+         *
+         * @modifies El enlace recibe el nodo que ocupa el lugar del eliminado y `size` disminuye.
+         *
+         * @effect En modo `TREAP` el nodo se reemplaza por la unión de sus dos hijos, lo que
+         *         equivale a rotarlo hacia abajo hasta que sea una hoja.
+         *
+         * @param link El puntero (raíz o hijo de un padre) que apunta al nodo a eliminar.
+         */
+        void removeAt(Node** link);
+
+        /**
+         * @brief Escribe el tamaño del árbol y sus nodos en preorden con una pila explícita.
+         */
+        void writeTo(BufferedWriter& writer) const;
+
+        /**
+         * @brief Escribe los nodos del subárbol de `node` en preorden con una pila explícita.
+         */
+        void writeTo(BufferedWriter& writer, const Node* node) const;
     public:
+        /**
+         * @brief Options accepted by the constructor.
+         *
+         * - `PLAIN`: an unbalanced binary search tree (default).
+         * - `TREAP`: a treap with random priorities, balanced in expectation.
+         */
+        enum Options {
+            PLAIN = 0,
+            TREAP = 1 << 0
+        };
+
         /**
          * @brief Constructs a new Tree object.
          * 
          * This constructor initializes the Tree with a null root and a size of zero.
+         *
+         * @param options `PLAIN` or `TREAP`.
          */
-        Bin()
+        explicit Bin(int options = PLAIN)
         : root(nullptr)
-        , size(0) {
+        , size(0)
+        , treap((options & TREAP) != 0)
+        , priorityState(0x9E3779B97F4A7C15ULL) {
 
         };
 
+        Bin(const Bin&) = delete;
+        Bin& operator=(const Bin&) = delete;
+
         /**
          * @brief Destructor for the Tree class.
          *
@@ -67,13 +184,12 @@ class Bin : public Dict {
 
 
         /**
-         * @brief Clears the AVLTree by deleting all nodes.
+         * @brief Deletes every node of a subtree.
          *
-         * @effect Recursively deletes all nodes in the AVLTree, starting from the root.
+         * @effect Rota hacia la derecha cada hijo izquierdo que encuentra y borra los nodos
+         *         que quedan sin él, así que no usa recursión aunque el árbol sea una cadena.
          *
-         * @require The AVLTree must be initialized with a valid root node.
-         *
-         * @modifies Modifies the structure of the AVLTree by deleting all nodes.
+         * @modifies Deletes the nodes of the subtree; the caller must drop the links to it.
          */
 
         void clear(Node* node);
@@ -86,6 +202,8 @@ class Bin : public Dict {
          *         Si el árbol no está vacío, busca la posición correcta para insertar el nuevo nodo
          *         de acuerdo a las reglas de un árbol binario de búsqueda.
          *         Si el elemento ya existe en el árbol, no realiza ninguna inserción.
+         *         En modo `TREAP` el nodo nuevo baja hasta el primer nodo de menor prioridad,
+         *         toma su lugar y parte ese subárbol en sus dos hijos.
          *
          * @require La clase Bin debe tener un puntero `root` inicializado y una variable `size`
          *          que rastrea el número de nodos en el árbol.
@@ -125,6 +243,7 @@ class Bin : public Dict {
          *         - Si el nodo tiene un solo hijo, ese hijo reemplaza al nodo.
          *         - Si el nodo no tiene hijos, simplemente se elimina.
          *         Si el elemento no se encuentra en el árbol, no se realiza ninguna acción.
+         *         En modo `TREAP` el nodo se reemplaza por la unión de sus hijos.
          *
          * @require El árbol debe estar inicializado y seguir las reglas de un árbol binario de búsqueda.
          *          El elemento debe ser comparable mediante operadores `<` y `>`.
@@ -137,37 +256,120 @@ class Bin : public Dict {
         void erase(int element) override;
 
         /**
-         * @brief Devuelve una representación en forma de cadena del árbol binario.
+         * @brief Inserta un lote de elementos recorriendo cada nodo del árbol a lo sumo una vez.
          *
-         * @effect No modifica la estructura del árbol. Construye una cadena que contiene
-         *         información sobre el tamaño del árbol y los elementos presentes.
+         * @effect Ordena el lote y lo reparte desde la raíz: los elementos menores al nodo siguen
+         *         por la izquierda y los mayores por la derecha. Los elementos que llegan a un
+         *         hijo nulo se enlazan allí como un subárbol balanceado. Usa una pila explícita,
+         *         por lo que no depende de la altura del árbol.
          *
-         * @require El árbol debe estar inicializado. La función auxiliar `toString(Node*)`
-         *          debe existir y ser capaz de recorrer el árbol a partir de la raíz.
+         * @modifies Agrega los elementos ausentes y aumenta `size`.
          *
-         * @modifies No modifica ningún atributo del árbol. Solo construye y devuelve una cadena
-         *           de texto con la información del árbol.
+         * @param elements Los elementos a insertar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         */
+        void insertMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Verifica un lote de elementos repartiéndolo desde la raíz como `insertMany`.
+         *
+         * @modifies `found`, que queda con `found[i]` indicando si `elements[i]` está presente.
+         *
+         * @param elements Los elementos a buscar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         * @param found El resultado de cada búsqueda.
+         */
+        void containsMany(const int* elements, size_t count, std::vector<bool>& found) override;
+
+        /**
+         * @brief Elimina un lote de elementos repartiéndolo desde la raíz como `insertMany`.
+         *
+         * @modifies Elimina los nodos encontrados y disminuye `size`.
+         *
+         * @param elements Los elementos a eliminar, en cualquier orden.
+         * @param count La cantidad de elementos.
+         */
+        void eraseMany(const int* elements, size_t count) override;
+
+        /**
+         * @brief Llama a `visit` con cada elemento del árbol, en preorden.
+         *
+         * @effect Recorre el árbol con una pila explícita, como `writeTo`.
+         *
+         * @return true, porque el árbol siempre puede listar sus elementos.
+         */
+        bool forEachElement(const std::function<void(int)>& visit) override;
+
+        /**
+         * @brief Devuelve una representación en forma de cadena del árbol binario.
+         *
+         * @effect No modifica la estructura del árbol. Es un envoltorio sobre `writeTo` que
+         *         junta en una cadena el tamaño del árbol y sus nodos en preorden.
          *
          * @return Una cadena de texto que incluye el tamaño del árbol y sus elementos.
          */
         std::string toString() override;
+
         /**
-         * @brief Devuelve una representación en forma de cadena de un nodo y sus hijos en el árbol binario.
-         *
-         * @effect No modifica la estructura del árbol. Genera una cadena de texto que representa
-         *         la información del nodo actual y sus hijos, de manera recursiva.
+         * @brief Devuelve una representación en forma de cadena de un nodo y sus descendientes.
          *
-         * @require El nodo `node` debe estar inicializado o ser nulo. Si no es nulo, debe tener accesibles
-         *          sus hijos izquierdos y derechos (si existen). Este método requiere que los valores de los
-         *          nodos sean convertibles a cadena mediante `std::to_string`.
+         * @effect No modifica la estructura del árbol. Es un envoltorio sobre `writeTo` que
+         *         junta en una cadena los nodos del subárbol en preorden, sin el tamaño.
          *
-         * @modifies No modifica la estructura del árbol ni ningún atributo de los nodos. 
-         *           Solo construye y devuelve una cadena de texto con la información de los nodos.
+         * @require El nodo `node` debe pertenecer al árbol o ser nulo.
          *
-         * @param node Un puntero al nodo del cual se quiere obtener la representación en cadena.
-         * @return Una cadena que describe el nodo actual, sus hijos (si tiene), y el resultado de las llamadas recursivas
-         *         sobre sus hijos izquierdo y derecho.
+         * @param node Un puntero a la raíz del subárbol que se quiere representar.
+         * @return Una cadena con una línea por nodo, o una cadena vacía si `node` es nulo.
          */
         std::string toString(Node* node);
+
+        /**
+         * @brief Escribe en `stream` lo mismo que devuelve `toString`, sin armar la cadena.
+         *
+         * @effect Recorre el árbol con una pila explícita y escribe por bloques, así que el
+         *         tiempo es lineal aun si el árbol degeneró en una lista.
+         *
+         * @return false si el flujo reportó un error.
+         */
+        bool writeTo(std::ostream& stream);
+
+        /**
+         * @brief Escribe en `file` lo mismo que devuelve `toString`, sin armar la cadena.
+         *
+         * @require `file` debe estar abierto para escritura.
+         *
+         * @return false si alguna escritura falló.
+         */
+        bool writeTo(FILE* file);
+
+        /**
+         * @brief Guarda las llaves en orden ascendente en un archivo de instantánea binario.
+         *
+         * @effect Escribe un encabezado con la cantidad de llaves y su suma de verificación,
+         *         seguido de las llaves, en un solo recorrido en orden y sin copiarlas antes.
+         *
+         * @param path La ruta del archivo, que se reemplaza si ya existe.
+         * @return false si el archivo no pudo escribirse.
+         */
+        bool saveSnapshot(const char* path);
+
+        /**
+         * @brief Reemplaza el contenido del árbol con el de una instantánea.
+         *
+         * @effect Proyecta el archivo en memoria con `mmap`, valida el encabezado y la suma de
+         *         verificación, y construye un árbol balanceado en O(n) directamente desde la proyección.
+         *
+         * @throws std::runtime_error si el archivo no existe o no es una instantánea válida.
+         *
+         * @param path La ruta del archivo guardado con `saveSnapshot`.
+         */
+        void loadSnapshot(const char* path);
+
+        /**
+         * @brief Devuelve la memoria ocupada por los nodos del árbol.
+         *
+         * @return La cantidad de bytes reservados para los nodos.
+         */
+        size_t memoryUsage() override;
         
 };
\ No newline at end of file
@@ -1,8 +1,12 @@
 #ifndef TIMETEST_H
 #define TIMETEST_H
+#include <algorithm>
 #include <chrono>
+#include <cmath>
 #include <cstdint>
 #include <memory>
+#include <thread>
+#include <vector>
 
 namespace xorshift64{
 
@@ -39,6 +43,29 @@ std::shared_ptr<int[]> createItemsInOrder(unsigned int size){
 	return array;
 }
 
+// Devuelve size accesos a las llaves de keys con distribución Zipf: la llave de la
+// posición r se elige con probabilidad proporcional a 1 / (r + 1)^exponent, así que
+// unas pocas llaves se llevan la mayoría de los accesos. Si keys viene en orden
+// aleatorio, las llaves calientes quedan repartidas por todo el rango
+std::shared_ptr<int[]> createItemsZipf(std::shared_ptr<int[]> keys, unsigned int keyCount, unsigned int size, double exponent = 0.99){
+	std::vector<double> cumulative(keyCount);
+	double total = 0;
+	for(unsigned int r = 0; r < keyCount; ++r){
+		total += 1.0 / std::pow(r + 1.0, exponent);
+		cumulative[r] = total;
+	}
+
+	std::shared_ptr<int[]> array(new int[size]);
+	xorshift64::seed(0x5A1F5A1F5A1F5A1FULL);
+	for(unsigned int i = 0; i < size; ++i){
+		// 53 bits al azar dan un double uniforme en [0, total)
+		double point = (xorshift64::random() >> 11) * (total / 9007199254740992.0);
+		size_t rank = std::upper_bound(cumulative.begin(), cumulative.end(), point) - cumulative.begin();
+		array[i] = keys[std::min<size_t>(rank, keyCount - 1)];
+	}
+	return array;
+}
+
 // Requiere: que el diccionario venga vacío
 template <typename T> double testInsert(T& collection, std::shared_ptr<int[]> array, unsigned int size){
 	// collection.clear();
@@ -71,4 +98,157 @@ template <typename T> double testErase(T& collection, std::shared_ptr<int[]> arr
 	return micros;
 }
 
+// Requiere: que el diccionario venga vacío
+template <typename T> double testInsertMany(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.insertMany(array.get(), size);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testContainsMany(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	std::vector<bool> found;
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.containsMany(array.get(), size, found);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testContainsPipelined(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	std::vector<bool> found;
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.containsPipelined(array.get(), size, found);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testEraseMany(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.eraseMany(array.get(), size);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+// Requiere: que el arreglo venga en orden ascendente
+template <typename T> double testBuildFromSorted(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.buildFromSorted(array.get(), size);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testBuildFromUnsorted(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.buildFromUnsorted(array.get(), size);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+// Requiere: que la colección tenga un método clear() sin parámetros
+template <typename T> double testClear(T& collection){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.clear();
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testUnionWith(T& collection, const T& other){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.unionWith(other);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testIntersectWith(T& collection, const T& other){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.intersectWith(other);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+template <typename T> double testDifferenceWith(T& collection, const T& other){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.differenceWith(other);
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+// Requiere: que la colección mantenga estadísticas de orden
+template <typename T> double testRank(T& collection, std::shared_ptr<int[]> array, unsigned int size){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for(unsigned int i = 0; i < size; ++i){
+		collection.rank(array[i]);
+	}
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+// Requiere: que la colección mantenga estadísticas de orden y tenga al menos size llaves
+template <typename T> double testSelect(T& collection, unsigned int size){
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for(unsigned int i = 0; i < size; ++i){
+		collection.select(i);
+	}
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+// Recorre las llaves en [lo, hi) y las acumula en sum para que el recorrido no se descarte
+template <typename T> double testScan(T& collection, int lo, int hi, long long& sum){
+	sum = 0;
+	auto tStart = std::chrono::high_resolution_clock::now();
+	collection.forEachInRange(lo, hi, [&sum](int key){
+		sum += key;
+	});
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
+// Requiere: que la colección sea segura entre hilos
+// Cada hilo hace operations operaciones sobre llaves en [0, keyRange): readPercent por ciento
+// son búsquedas y el resto se reparte entre inserciones y eliminaciones
+template <typename T> double testThroughput(T& collection, unsigned int threads, unsigned int operations, unsigned int readPercent, unsigned int keyRange){
+	std::vector<std::thread> workers;
+	auto tStart = std::chrono::high_resolution_clock::now();
+	for(unsigned int t = 0; t < threads; ++t){
+		workers.emplace_back([&collection, operations, readPercent, keyRange, t](){
+			// Un generador por hilo para no compartir el estado de xorshift64
+			uint64_t state = 0x9E3779B97F4A7C15ULL * (t + 1);
+			for(unsigned int i = 0; i < operations; ++i){
+				state ^= state << 13;
+				state ^= state >> 7;
+				state ^= state << 17;
+				int key = (int)((state >> 16) % keyRange);
+				unsigned int choice = (unsigned int)(state % 100);
+				if(choice < readPercent){
+					collection.contains(key);
+				} else if(choice & 1){
+					collection.insert(key);
+				} else {
+					collection.erase(key);
+				}
+			}
+		});
+	}
+	for(std::thread& worker : workers){
+		worker.join();
+	}
+	auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+	double micros = std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count();
+	return micros;
+}
+
 #endif // TIMETEST_H
@@ -3,7 +3,11 @@
 #ifndef MEDICIONES_CPP
 #define MEDICIONES_CPP
 
+#include <climits>
+#include <cstdint>
+#include <cstdio>
 #include <iostream>
+#include <thread>
 #include "TimeTest.h"
 
 #include "../Dict/Dict.h"
@@ -11,8 +15,25 @@
 
 // Comment or uncomment if necessary
 #include "../DictList/DictList.hpp"
+#include "../UnrolledDictList/UnrolledDictList.hpp"
 #include "../binario/Bin.hpp"
 #include "../AVLTree/AVLTree.hpp"
+#include "../BPlusTree/BPlusTree.hpp"
+#include "../CompactAVLTree/CompactAVLTree.hpp"
+#include "../GenericAVLTree/GenericAVLDict.hpp"
+#include "../ConcurrentAVLTree/ConcurrentAVLTree.hpp"
+#include "../LockedDict/LockedDict.hpp"
+#include "../PersistentAVLTree/PersistentAVLTree.hpp"
+#include "../Serialization/Snapshot.hpp"
+#include "../FrozenDict/FrozenDict.hpp"
+#include "../HashDict/HashDict.hpp"
+#include "../SkipListDict/SkipListDict.hpp"
+#include "../SplayTree/SplayTree.hpp"
+#include "../AdaptiveRadixTree/AdaptiveRadixTree.hpp"
+#include "../LsmDict/LsmDict.hpp"
+#include "../FilteredDict/FilteredDict.hpp"
+#include "../PackedMemoryArray/PackedMemoryArray.hpp"
+#include "../LearnedDict/LearnedDict.hpp"
 // #include "../DictAVLTree/DictAVLTree.hpp"
 
 
@@ -28,7 +49,8 @@
  * Effects Performs the insert, search (contains), and erase operations on the
  *         dictionary three times for the given array of integers. Measures and
  *         outputs the time for each operation in every iteration. Calculates
- *         and outputs the average time for each operation.
+ *         and outputs the average time for each operation, and the memory per
+ *         key held by the dictionary once it is full.
  *
  * Modifies the dictionary by inserting and erasing elements as part of the
  * measurement.
@@ -39,21 +61,23 @@ void triplMeasureTime(Dict& dict, std::shared_ptr<int[]> array, unsigned int
   double insertTotalTime = 0;
   double containsTotalTime = 0;
   double eraseTotalTime = 0;
+  double bytesPerKey = 0;
 
   // Loop to perform each operation 3 times
   for (int i = 1; i < 4; ++i) {
     // Measure the time for each operation
     double insertTime = testInsert(dict, array, size);
+    bytesPerKey = static_cast<double>(dict.memoryUsage()) / size;
     double containsTime = testContains(dict, array, size);
     double eraseTime = testErase(dict, array, size);
 
     // Output the time taken for each operation in the current iteration
     std::cout << "Time taken to insert iteration: " << i << " = " << insertTime
-        << "ms" << std::endl;
+        << "us" << std::endl;
     std::cout << "Time taken to search iteration: " << i << " = " <<
-        containsTime << "ms" << std::endl;;
+        containsTime << "us" << std::endl;;
     std::cout << "Time taken to delete iteration: " << i << " = " << eraseTime
-        << "ms" << std::endl;
+        << "us" << std::endl;
 
     // Accumulate the times for calculating the average later
     insertTotalTime += insertTime;
@@ -62,12 +86,59 @@ void triplMeasureTime(Dict& dict, std::shared_ptr<int[]> array, unsigned int
   }
 
   // Output the average time for each operation (insert, contains, erase)
-  std::cout << "Average insert time: " << insertTotalTime / 3 << "ms" <<
+  std::cout << "Average insert time: " << insertTotalTime / 3 << "us" <<
       std::endl;;
-  std::cout << "Average search time: " << containsTotalTime / 3 << "ms" <<
+  std::cout << "Average search time: " << containsTotalTime / 3 << "us" <<
       std::endl;;
-  std::cout << "Average delete time: " << eraseTotalTime / 3 << "ms" <<
+  std::cout << "Average delete time: " << eraseTotalTime / 3 << "us" <<
       std::endl;;
+  std::cout << "Memory per key: " << bytesPerKey << " bytes" << std::endl;
+}
+
+
+/**
+ * @brief Measures the batched insert, search (contains), and erase paths of a
+ *        dictionary, running each operation three times and calculating the
+ *        average time.
+ *
+ * Requires A valid, empty dictionary object `dict` and a valid array of
+ *          integers `array` with a size equal to `size`.
+ *
+ * Effects Hands the whole array to insertMany, containsMany, and eraseMany
+ *         three times, outputting the time of each call and the averages.
+ *
+ * Modifies the dictionary by inserting and erasing elements as part of the
+ * measurement.
+ */
+void triplMeasureBatchTime(Dict& dict, std::shared_ptr<int[]> array,
+    unsigned int size) {
+  double insertTotalTime = 0;
+  double containsTotalTime = 0;
+  double eraseTotalTime = 0;
+
+  for (int i = 1; i < 4; ++i) {
+    double insertTime = testInsertMany(dict, array, size);
+    double containsTime = testContainsMany(dict, array, size);
+    double eraseTime = testEraseMany(dict, array, size);
+
+    std::cout << "Time taken to batch insert iteration: " << i << " = "
+        << insertTime << "us" << std::endl;
+    std::cout << "Time taken to batch search iteration: " << i << " = "
+        << containsTime << "us" << std::endl;
+    std::cout << "Time taken to batch delete iteration: " << i << " = "
+        << eraseTime << "us" << std::endl;
+
+    insertTotalTime += insertTime;
+    containsTotalTime += containsTime;
+    eraseTotalTime += eraseTime;
+  }
+
+  std::cout << "Average batch insert time: " << insertTotalTime / 3 << "us"
+      << std::endl;
+  std::cout << "Average batch search time: " << containsTotalTime / 3 << "us"
+      << std::endl;
+  std::cout << "Average batch delete time: " << eraseTotalTime / 3 << "us"
+      << std::endl;
 }
 
 
@@ -81,9 +152,10 @@ void triplMeasureTime(Dict& dict, std::shared_ptr<int[]> array, unsigned int
  *           the different input sizes for the measurements.
  *
  * Effects Iterates over the array `sizes`, generating random and sorted arrays
- *          of integers for each size. Calls the function `triplMeasureTime`
- *          for each array (random and sorted), measuring the performance of
- *          insert, contains, and erase operations on the dictionary. Outputs
+ *          of integers for each size. Calls the functions `triplMeasureTime`
+ *          and `triplMeasureBatchTime` for each array (random and sorted),
+ *          measuring the performance of the one-key and batched insert,
+ *          contains, and erase operations on the dictionary. Outputs
  *          the size and type of order (random or ascending) for each set of
  *          measurements to the standard output.
  *
@@ -100,6 +172,7 @@ void runMeasurements(Dict& dict, const int (&sizes)[lenSizes]) {
         << "random order" << std::endl;
     // Perform the triple measurement on random order data
     triplMeasureTime(dict, randomNumbers, sizes[i]);
+    triplMeasureBatchTime(dict, randomNumbers, sizes[i]);
 
     std::shared_ptr<int[]> sortedNumbers = createItemsInOrder(sizes[i]);
     // Output the size and type of measurement (ascending order)
@@ -107,6 +180,626 @@ void runMeasurements(Dict& dict, const int (&sizes)[lenSizes]) {
         << "ascending order" << std::endl;
     // Perform the triple measurement on ascending order data
     triplMeasureTime(dict, sortedNumbers, sizes[i]);
+    triplMeasureBatchTime(dict, sortedNumbers, sizes[i]);
+  }
+}
+
+/**
+ * @brief Same as `runMeasurements`, but the operations are called on the
+ *        concrete collection type, so there is no virtual dispatch and the
+ *        compiler can inline them into the timing loops.
+ *
+ * Requires A valid, empty collection with insert, contains, and erase
+ *          methods that accept an `int`, and a valid array `sizes` with the
+ *          input sizes.
+ *
+ * Effects For every size, runs the one-key insert, contains, and erase loops
+ *         three times on random and ascending data and outputs the averages.
+ *
+ * Modifies the collection by inserting and erasing elements as part of the
+ *          measurement.
+ */
+template <typename T, size_t lenSizes>
+void runDirectMeasurements(T& collection, const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> arrays[2] = {createItemsRandom(sizes[i]),
+        createItemsInOrder(sizes[i])};
+    const char* orders[2] = {"random", "ascending"};
+
+    for (int order = 0; order < 2; ++order) {
+      double insertTotalTime = 0;
+      double containsTotalTime = 0;
+      double eraseTotalTime = 0;
+      for (int j = 1; j < 4; ++j) {
+        insertTotalTime += testInsert(collection, arrays[order], sizes[i]);
+        containsTotalTime += testContains(collection, arrays[order], sizes[i]);
+        eraseTotalTime += testErase(collection, arrays[order], sizes[i]);
+      }
+
+      std::cout << std::endl << "Measure for " << sizes[i] << " elements in "
+          << orders[order] << " order" << std::endl;
+      std::cout << "Average insert time: " << insertTotalTime / 3 << "us"
+          << std::endl;
+      std::cout << "Average search time: " << containsTotalTime / 3 << "us"
+          << std::endl;
+      std::cout << "Average delete time: " << eraseTotalTime / 3 << "us"
+          << std::endl;
+    }
+  }
+}
+
+/**
+ * @brief Measures how long it takes to release a full dictionary at once,
+ *        for every input size and for both random and ascending order data.
+ *
+ * Requires A valid, empty tree `tree` with a `clear()` method and a valid
+ *          array `sizes` with the input sizes.
+ *
+ * Effects Fills the tree with each generated array and outputs the time taken
+ *         by `clear()` to release all of its nodes.
+ *
+ * Modifies the tree by inserting elements and clearing it again.
+ */
+template <size_t lenSizes>
+void runClearMeasurements(AVLTree& tree, const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    testInsert(tree, randomNumbers, sizes[i]);
+    std::cout << "Time taken to clear " << sizes[i] << " elements in random "
+        << "order = " << testClear(tree) << "us" << std::endl;
+
+    std::shared_ptr<int[]> sortedNumbers = createItemsInOrder(sizes[i]);
+    testInsert(tree, sortedNumbers, sizes[i]);
+    std::cout << "Time taken to clear " << sizes[i] << " elements in "
+        << "ascending order = " << testClear(tree) << "us" << std::endl;
+  }
+}
+
+/**
+ * @brief Compares the startup time of an AVL tree loaded by replaying one
+ *        insert per key against the linear-time bulk loads.
+ *
+ * Requires A valid array `sizes` with the input sizes.
+ *
+ * Effects For every size, loads an ascending array by replaying inserts and
+ *         with `buildFromSorted`, and a random array by replaying inserts and
+ *         with `buildFromUnsorted`. Then saves the tree to a snapshot file and
+ *         times reloading it and searching every key straight from the mapped
+ *         file, outputting the time of each load in microseconds.
+ *
+ * Modifies A temporary snapshot file in the working directory, removed
+ *          after each size.
+ */
+template <size_t lenSizes>
+void runStartupMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> sortedNumbers = createItemsInOrder(sizes[i]);
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    std::cout << std::endl << "Startup for " << sizes[i] << " elements"
+        << std::endl;
+
+    AVLTree replayedSorted;
+    std::cout << "Time taken to replay inserts in ascending order = "
+        << testInsert(replayedSorted, sortedNumbers, sizes[i]) << "us"
+        << std::endl;
+    AVLTree builtSorted;
+    std::cout << "Time taken to buildFromSorted = "
+        << testBuildFromSorted(builtSorted, sortedNumbers, sizes[i]) << "us"
+        << std::endl;
+
+    AVLTree replayedRandom;
+    std::cout << "Time taken to replay inserts in random order = "
+        << testInsert(replayedRandom, randomNumbers, sizes[i]) << "us"
+        << std::endl;
+    AVLTree builtRandom;
+    std::cout << "Time taken to buildFromUnsorted = "
+        << testBuildFromUnsorted(builtRandom, randomNumbers, sizes[i]) << "us"
+        << std::endl;
+
+    const char* path = "startup.snapshot";
+    if (!builtRandom.saveSnapshot(path)) {
+      std::cout << "Could not write " << path << std::endl;
+      continue;
+    }
+    AVLTree loaded;
+    auto tStart = std::chrono::high_resolution_clock::now();
+    loaded.loadSnapshot(path);
+    auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::cout << "Time taken to loadSnapshot = "
+        << std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count()
+        << "us" << std::endl;
+
+    // Serve the searches straight from the mapped file, without a tree
+    tStart = std::chrono::high_resolution_clock::now();
+    size_t found = 0;
+    {
+      MappedSnapshot mapped(path);
+      for (int j = 0; j < sizes[i]; ++j) {
+        found += mapped.contains(randomNumbers[j]);
+      }
+    }
+    tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::cout << "Time taken to map the snapshot and search " << found
+        << " elements = "
+        << std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count()
+        << "us" << std::endl;
+    std::remove(path);
+  }
+}
+
+/**
+ * @brief Compares one-at-a-time lookups against the two batched engines.
+ *
+ * Requires A valid array `sizes` with the input sizes.
+ *
+ * Effects For every size, fills a tree one insert at a time, so its nodes
+ *         are scattered in memory as in a long-running service, and outputs
+ *         the time of searching every key with `contains`, with the sorted
+ *         single pass of `containsMany` and with `containsPipelined`.
+ *
+ * Modifies Nothing outside of the tree created for each size.
+ */
+template <size_t lenSizes>
+void runPipelinedMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    AVLTree tree;
+    for (int j = 0; j < sizes[i]; ++j) {
+      tree.insert(randomNumbers[j]);
+    }
+
+    std::cout << "Time taken to search " << sizes[i] << " elements one by one = "
+        << testContains(tree, randomNumbers, sizes[i]) << "us" << std::endl;
+    std::cout << "Time taken to search " << sizes[i]
+        << " elements with containsMany = "
+        << testContainsMany(tree, randomNumbers, sizes[i]) << "us" << std::endl;
+    std::cout << "Time taken to search " << sizes[i]
+        << " elements with containsPipelined = "
+        << testContainsPipelined(tree, randomNumbers, sizes[i]) << "us"
+        << std::endl;
+  }
+}
+
+/**
+ * @brief Compares the lookups and memory of a live AVL tree with its frozen
+ *        Eytzinger copy.
+ *
+ * Requires A valid array `sizes` with the input sizes.
+ *
+ * Effects For every size, fills a tree one insert at a time, freezes it, and
+ *         outputs the time of `freeze`, the time of searching every key in
+ *         both dictionaries, all in microseconds, and the bytes each one uses
+ *         per key.
+ *
+ * Modifies Nothing outside of the dictionaries created for each size.
+ */
+template <size_t lenSizes>
+void runFrozenMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    AVLTree tree;
+    for (int j = 0; j < sizes[i]; ++j) {
+      tree.insert(randomNumbers[j]);
+    }
+
+    auto tStart = std::chrono::high_resolution_clock::now();
+    FrozenDict frozen = tree.freeze();
+    auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::cout << "Time taken to freeze " << frozen.count() << " elements = "
+        << std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count()
+        << "us" << std::endl;
+
+    std::cout << "Time taken to search " << sizes[i] << " elements in the tree = "
+        << testContains(tree, randomNumbers, sizes[i]) << "us" << std::endl;
+    std::cout << "Time taken to search " << sizes[i]
+        << " elements in the frozen copy = "
+        << testContains(frozen, randomNumbers, sizes[i]) << "us" << std::endl;
+    std::cout << "Bytes per key: tree = "
+        << static_cast<double>(tree.memoryUsage()) / frozen.count()
+        << ", frozen = "
+        << static_cast<double>(frozen.memoryUsage()) / frozen.count()
+        << std::endl;
+  }
+}
+
+/**
+ * @brief Compares the learned index with the other read-mostly structures on
+ *        the same frozen keys.
+ *
+ * Requires A valid array `sizes` with the input sizes and a generator
+ *          `createItems` from TimeTest.h.
+ *
+ * Effects For every size, fills an AVL tree with the generated keys, builds a
+ *         FrozenDict, a PackedMemoryArray and a LearnedDict with the same
+ *         keys, and outputs the time of building the LearnedDict and of
+ *         searching every key in each structure, all in microseconds, the
+ *         bytes each one uses per key and the widest search window of the
+ *         learned index.
+ *
+ * Modifies Nothing outside of the dictionaries created for each size.
+ */
+template <size_t lenSizes>
+void runLearnedMeasurements(const int (&sizes)[lenSizes],
+    std::shared_ptr<int[]> (*createItems)(unsigned int)) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> keys = createItems(sizes[i]);
+    AVLTree tree;
+    for (int j = 0; j < sizes[i]; ++j) {
+      tree.insert(keys[j]);
+    }
+    FrozenDict frozen = tree.freeze();
+    PackedMemoryArray packed;
+    packed.insertMany(keys.get(), sizes[i]);
+
+    auto tStart = std::chrono::high_resolution_clock::now();
+    LearnedDict learned(tree);
+    auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+
+    double keyCount = static_cast<double>(learned.count());
+    std::cout << std::endl << "Measure for " << sizes[i] << " elements"
+        << std::endl;
+    std::cout << "Time taken to train the learned index = "
+        << std::chrono::duration_cast<std::chrono::microseconds>(tDelta).count()
+        << "us, max search width: " << learned.maxSearchWidth() << std::endl;
+    std::cout << "AVL tree search time: "
+        << testContains(tree, keys, sizes[i]) << "us" << std::endl;
+    std::cout << "Frozen AVL tree search time: "
+        << testContains(frozen, keys, sizes[i]) << "us" << std::endl;
+    std::cout << "Packed memory array search time: "
+        << testContains(packed, keys, sizes[i]) << "us" << std::endl;
+    std::cout << "Learned index search time: "
+        << testContains(learned, keys, sizes[i]) << "us" << std::endl;
+    std::cout << "Bytes per key: tree = " << tree.memoryUsage() / keyCount
+        << ", frozen = " << frozen.memoryUsage() / keyCount
+        << ", packed = " << packed.memoryUsage() / keyCount
+        << ", learned = " << learned.memoryUsage() / keyCount << std::endl;
+  }
+}
+
+/**
+ * @brief Compares merging two AVL trees key by key against the join-based
+ *        set operations.
+ *
+ * Requires A valid array `sizes` with the input sizes.
+ *
+ * Effects For every size, fills two trees with random keys that overlap by
+ *         half, and outputs the time of a key-by-key union, `unionWith`,
+ *         `intersectWith` and `differenceWith`.
+ *
+ * Modifies Nothing outside of the trees created for each size.
+ */
+template <size_t lenSizes>
+void runSetOperationMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    unsigned int half = sizes[i] / 2;
+    // The second tree starts halfway through the keys of the first one
+    std::shared_ptr<int[]> shifted(randomNumbers, randomNumbers.get() + half / 2);
+    std::cout << std::endl << "Set operations for two trees of " << half
+        << " elements" << std::endl;
+
+    AVLTree first;
+    AVLTree second;
+    first.buildFromUnsorted(randomNumbers.get(), half);
+    second.buildFromUnsorted(shifted.get(), half);
+
+    AVLTree replayed;
+    replayed.buildFromUnsorted(randomNumbers.get(), half);
+    std::cout << "Time taken to union by inserting each key = "
+        << testInsert(replayed, shifted, half) << "us"
+        << std::endl;
+
+    AVLTree merged;
+    merged.buildFromUnsorted(randomNumbers.get(), half);
+    std::cout << "Time taken to unionWith = "
+        << testUnionWith(merged, second) << "us" << std::endl;
+
+    AVLTree common;
+    common.buildFromUnsorted(randomNumbers.get(), half);
+    std::cout << "Time taken to intersectWith = "
+        << testIntersectWith(common, second) << "us" << std::endl;
+
+    std::cout << "Time taken to differenceWith = "
+        << testDifferenceWith(first, second) << "us" << std::endl;
+  }
+}
+
+/**
+ * @brief Measures the order-statistic queries of an AVL tree that keeps the
+ *        size of every subtree.
+ *
+ * Requires A valid array `sizes` with the input sizes.
+ *
+ * Effects For every size, loads a tree built with `ORDER_STATISTICS` with
+ *         random keys and outputs the time of one `rank` per key and one
+ *         `select` per position.
+ *
+ * Modifies Nothing outside of the tree created for each size.
+ */
+template <size_t lenSizes>
+void runOrderStatisticMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    AVLTree tree(AVLTree::ORDER_STATISTICS);
+    testInsert(tree, randomNumbers, sizes[i]);
+    // Repeated random keys are stored only once
+    unsigned int stored = tree.countRange(INT_MIN, INT_MAX);
+
+    std::cout << "Time taken to rank " << sizes[i] << " elements = "
+        << testRank(tree, randomNumbers, sizes[i]) << "us" << std::endl;
+    std::cout << "Time taken to select " << stored << " positions = "
+        << testSelect(tree, stored) << "us" << std::endl;
+  }
+}
+
+/**
+ * @brief Measures full and partial range scans over an ordered collection.
+ *
+ * Requires A valid array `sizes` with the input sizes, and a collection type
+ *          `T` with `insertMany` and `forEachInRange`.
+ *
+ * Effects For every size, loads a collection with ascending keys and outputs
+ *         the time of `forEachInRange` over every key and over the middle
+ *         half. The sum of the keys is printed too, so the compiler cannot
+ *         drop a scan whose result would otherwise be unused.
+ *
+ * Modifies Nothing outside of the collection created for each size.
+ */
+template <typename T, size_t lenSizes>
+void runScanMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> sortedNumbers = createItemsInOrder(sizes[i]);
+    T collection;
+    collection.insertMany(sortedNumbers.get(), sizes[i]);
+
+    long long sum;
+    double time = testScan(collection, INT_MIN, INT_MAX, sum);
+    std::cout << "Time taken to scan " << sizes[i] << " elements = " << time
+        << "us (sum " << sum << ")" << std::endl;
+    time = testScan(collection, sizes[i] / 4, sizes[i] / 4 * 3, sum);
+    std::cout << "Time taken to scan the middle " << sizes[i] / 2
+        << " elements = " << time << "us (sum " << sum << ")" << std::endl;
+  }
+}
+
+/**
+ * @brief Measures dumping a tree as text, into a string and streamed to a file.
+ *
+ * Requires A non-empty array of positive sizes.
+ *
+ * Effects For every size, loads a tree with random keys and outputs the time
+ *         of `toString` and of `writeTo` into a temporary file.
+ *
+ * Modifies Nothing outside of the tree created for each size.
+ */
+template <size_t lenSizes>
+void runDumpMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    AVLTree tree;
+    tree.insertMany(randomNumbers.get(), sizes[i]);
+
+    auto tStart = std::chrono::high_resolution_clock::now();
+    size_t length = tree.toString().size();
+    auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::cout << "Time taken to build the string of " << sizes[i]
+        << " elements = "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(tDelta).count()
+        << "ms (" << length << " bytes)" << std::endl;
+
+    FILE* file = std::tmpfile();
+    if (file == nullptr) {
+      continue;
+    }
+    tStart = std::chrono::high_resolution_clock::now();
+    tree.writeTo(file);
+    tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::fclose(file);
+    std::cout << "Time taken to stream " << sizes[i] << " elements = "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(tDelta).count()
+        << "ms" << std::endl;
+  }
+}
+
+/**
+ * @brief Measures the cost of taking snapshots of a persistent tree.
+ *
+ * Requires A non-empty array of positive sizes.
+ *
+ * Effects For every size, loads a persistent tree with random keys and
+ *         outputs the time of taking and dropping one snapshot per key,
+ *         which stays constant as the tree grows, and the time of inserting
+ *         new keys while a snapshot keeps the previous version alive.
+ *
+ * Modifies Nothing outside of the tree created for each size.
+ */
+template <size_t lenSizes>
+void runSnapshotMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> randomNumbers = createItemsRandom(sizes[i]);
+    PersistentAVLTree tree;
+    for (int j = 0; j < sizes[i]; ++j) {
+      tree.insert(randomNumbers[j]);
+    }
+
+    size_t found = 0;
+    auto tStart = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < sizes[i]; ++j) {
+      found += tree.snapshot().count();
+    }
+    auto tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::cout << "Time taken to take " << sizes[i] << " snapshots = "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(tDelta).count()
+        << "ms (" << found / sizes[i] << " keys each)" << std::endl;
+
+    PersistentAVLTree::Snapshot before = tree.snapshot();
+    tStart = std::chrono::high_resolution_clock::now();
+    for (int j = 0; j < sizes[i]; ++j) {
+      tree.insert(sizes[i] + j);
+    }
+    tDelta = std::chrono::high_resolution_clock::now() - tStart;
+    std::cout << "Time taken to insert " << sizes[i]
+        << " elements over a snapshot of " << before.count() << " = "
+        << std::chrono::duration_cast<std::chrono::milliseconds>(tDelta).count()
+        << "ms" << std::endl;
+  }
+}
+
+/**
+ * @brief Compares uniform searches with searches that follow a Zipf
+ *        distribution, where a few hot keys take most of the accesses.
+ *
+ * Requires A valid, empty dictionary `dict` and a valid array `sizes` with the
+ *          input sizes.
+ *
+ * Effects For every size, inserts that many random keys, times one search of
+ *         each key and then as many searches drawn with createItemsZipf, and
+ *         outputs both times before erasing the keys.
+ *
+ * Modifies the dictionary by inserting and erasing elements as part of the
+ *          measurement.
+ */
+template <size_t lenSizes>
+void runSkewedMeasurements(Dict& dict, const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> keys = createItemsRandom(sizes[i]);
+    std::shared_ptr<int[]> accesses = createItemsZipf(keys, sizes[i], sizes[i]);
+
+    testInsert(dict, keys, sizes[i]);
+    double uniformTime = testContains(dict, keys, sizes[i]);
+    double skewedTime = testContains(dict, accesses, sizes[i]);
+    testErase(dict, keys, sizes[i]);
+
+    std::cout << std::endl << "Measure for " << sizes[i] << " elements"
+        << std::endl;
+    std::cout << "Time taken to search every key once: " << uniformTime
+        << "us" << std::endl;
+    std::cout << "Time taken to search " << sizes[i]
+        << " Zipf-distributed keys: " << skewedTime << "us" << std::endl;
+  }
+}
+
+/**
+ * @brief Measures searches where most of the keys are missing, the case a
+ *        Bloom filter in front of the dictionary is meant for.
+ *
+ * Requires A valid, empty dictionary `dict` and a valid array `sizes` with
+ *          the input sizes.
+ *
+ * Effects For every size inserts random even keys, then searches as many
+ *         keys of which only one in ten is stored (the rest are the odd
+ *         neighbors of stored keys), and outputs the time taken.
+ *
+ * Modifies the dictionary by inserting and erasing elements as part of the
+ *          measurement.
+ */
+template <size_t lenSizes>
+void runMissMeasurements(Dict& dict, const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> keys = createItemsRandom(sizes[i]);
+    std::shared_ptr<int[]> lookups(new int[sizes[i]]);
+    for (int j = 0; j < sizes[i]; ++j) {
+      keys[j] &= ~1;
+      lookups[j] = j % 10 == 0 ? keys[j] : keys[j] | 1;
+    }
+
+    testInsert(dict, keys, sizes[i]);
+    double searchTime = testContains(dict, lookups, sizes[i]);
+    testErase(dict, keys, sizes[i]);
+
+    std::cout << std::endl << "Measure for " << sizes[i] << " elements"
+        << std::endl;
+    std::cout << "Time taken to search " << sizes[i]
+        << " keys, 90% missing: " << searchTime << "us" << std::endl;
+  }
+}
+
+/**
+ * @brief Compares the insert throughput of the LSM dictionary with the AVL
+ *        tree it uses as memtable, and reports what it costs the searches.
+ *
+ * Requires A valid array `sizes` with the input sizes.
+ *
+ * Effects For every size inserts the same random keys into a new AVL tree and
+ *         a new LsmDict, then searches every key in both, and outputs the
+ *         insertions per millisecond, the search times, the runs left and
+ *         the structures probed on average by each LsmDict search.
+ *
+ * Modifies Nothing outside the dictionaries it creates.
+ */
+template <size_t lenSizes>
+void runLsmMeasurements(const int (&sizes)[lenSizes]) {
+  for (size_t i = 0; i < lenSizes; ++i) {
+    std::shared_ptr<int[]> keys = createItemsRandom(sizes[i]);
+
+    AVLTree tree;
+    LsmDict lsm;
+    double treeInsertTime = testInsert(tree, keys, sizes[i]);
+    double lsmInsertTime = testInsert(lsm, keys, sizes[i]);
+    double treeSearchTime = testContains(tree, keys, sizes[i]);
+    lsm.resetStatistics();
+    double lsmSearchTime = testContains(lsm, keys, sizes[i]);
+
+    std::cout << std::endl << "Measure for " << sizes[i] << " elements"
+        << std::endl;
+    std::cout << "AVL tree inserts: " << sizes[i] / treeInsertTime * 1000
+        << " per ms" << std::endl;
+    std::cout << "LSM inserts: " << sizes[i] / lsmInsertTime * 1000
+        << " per ms" << std::endl;
+    std::cout << "AVL tree search time: " << treeSearchTime << "us"
+        << std::endl;
+    std::cout << "LSM search time: " << lsmSearchTime << "us" << std::endl;
+    std::cout << "LSM runs: " << lsm.runCount() << ", compactions: "
+        << lsm.compactionCount() << ", read amplification: "
+        << lsm.readAmplification() << std::endl;
+  }
+}
+
+/**
+ * @brief Measures how the throughput of a thread-safe dictionary scales with
+ *        the number of threads, from a read-heavy mix to an ingestion-like
+ *        write-heavy one.
+ *
+ * Requires A valid, empty dictionary `dict` that can be used from several
+ *          threads at once.
+ *
+ * Effects Fills the dictionary with every other key of the range, then for 1,
+ *         2, 4, ... threads up to the hardware concurrency runs a fixed number
+ *         of operations per thread with 90%, 50% and 10% searches, and
+ *         outputs the operations per millisecond of each run.
+ *
+ * Modifies the dictionary, which ends with an unspecified subset of the keys.
+ */
+void runThroughputMeasurements(Dict& dict) {
+  const unsigned int keyRange = 1 << 20;
+  const unsigned int operations = 1 << 18;
+  const unsigned int readPercents[] = {90, 50, 10};
+
+  for (unsigned int key = 0; key < keyRange; key += 2) {
+    dict.insert(key);
+  }
+
+  unsigned int maxThreads = std::thread::hardware_concurrency();
+  if (maxThreads == 0) {
+    maxThreads = 1;
+  }
+
+  for (unsigned int readPercent : readPercents) {
+    std::cout << std::endl << "Throughput with " << readPercent
+        << "% searches" << std::endl;
+    for (unsigned int threads = 1; ; threads *= 2) {
+      if (threads > maxThreads) {
+        threads = maxThreads;
+      }
+      double micros = testThroughput(dict, threads, operations, readPercent,
+          keyRange);
+      std::cout << threads << " threads = "
+          << threads * static_cast<double>(operations) / micros * 1000
+          << " ops/ms" << std::endl;
+      if (threads == maxThreads) {
+        break;
+      }
+    }
   }
 }
 
@@ -124,16 +817,252 @@ int main() {
     DictList dictList;
     runMeasurements(dictList, sizes);
 
+    std::cout << "============== UNROLLED LIST ==============" << std::endl;
+
+    UnrolledDictList dictUnrolledList;
+    runMeasurements(dictUnrolledList, sizes);
+
     std::cout << "============== BINARY TREE ==============" << std::endl;
 
     Bin dictBynaryTree;
     runMeasurements(dictBynaryTree, sizes);
 
+    std::cout << "============== BINARY TREE (TREAP) ==============" << std::endl;
+
+    Bin dictTreap(Bin::TREAP);
+    runMeasurements(dictTreap, sizes);
+
 
     std::cout << "============== AVL TREE ==============" << std::endl;
 
     AVLTree dictAVLTree;
     runMeasurements(dictAVLTree, sizes);
+    std::cout << std::endl;
+    runClearMeasurements(dictAVLTree, sizes);
+
+    std::cout << "============== B+ TREE ==============" << std::endl;
+
+    BPlusTree dictBPlusTree;
+    runMeasurements(dictBPlusTree, sizes);
+
+    std::cout << "============== B+ TREE RANGE SCANS ==============" << std::endl;
+
+    runScanMeasurements<BPlusTree>(sizes);
+
+    std::cout << "============== HASH TABLE ==============" << std::endl;
+
+    HashDict dictHash;
+    runMeasurements(dictHash, sizes);
+
+    std::cout << "============== SPLAY TREE ==============" << std::endl;
+
+    SplayTree dictSplayTree;
+    runMeasurements(dictSplayTree, sizes);
+
+    std::cout << "============== SKEWED ACCESS: AVL TREE ==============" << std::endl;
+
+    AVLTree skewedAVLTree;
+    runSkewedMeasurements(skewedAVLTree, sizes);
+
+    std::cout << "============== SKEWED ACCESS: BINARY TREE ==============" << std::endl;
+
+    Bin skewedBinaryTree;
+    runSkewedMeasurements(skewedBinaryTree, sizes);
+
+    std::cout << "============== SKEWED ACCESS: SPLAY TREE ==============" << std::endl;
+
+    SplayTree skewedSplayTree;
+    runSkewedMeasurements(skewedSplayTree, sizes);
+
+    std::cout << "============== ADAPTIVE RADIX TREE ==============" << std::endl;
+
+    AdaptiveRadixTree dictRadixTree;
+    runMeasurements(dictRadixTree, sizes);
+
+    std::cout << "============== ADAPTIVE RADIX TREE RANGE SCANS ==============" << std::endl;
+
+    runScanMeasurements<AdaptiveRadixTree>(sizes);
+
+    std::cout << "============== PACKED MEMORY ARRAY ==============" << std::endl;
+
+    PackedMemoryArray dictPackedArray;
+    runMeasurements(dictPackedArray, sizes);
+
+    std::cout << "============== PACKED MEMORY ARRAY RANGE SCANS ==============" << std::endl;
+
+    runScanMeasurements<PackedMemoryArray>(sizes);
+
+    // The B+ tree and the radix tree touch fewer cache lines per key than the
+    // AVL tree's ~log n nodes, so the gap only shows with inputs larger than
+    // the usual sizes
+    const int largeSizes[] = {1048576, 2097152, 4194304};
+
+    std::cout << "============== LARGE INPUTS: AVL TREE ==============" << std::endl;
+
+    AVLTree largeAVLTree;
+    runMeasurements(largeAVLTree, largeSizes);
+
+    std::cout << "============== LARGE INPUTS: B+ TREE ==============" << std::endl;
+
+    BPlusTree largeBPlusTree;
+    runMeasurements(largeBPlusTree, largeSizes);
+
+    std::cout << "============== LARGE INPUTS: ADAPTIVE RADIX TREE ==============" << std::endl;
+
+    AdaptiveRadixTree largeRadixTree;
+    runMeasurements(largeRadixTree, largeSizes);
+
+    std::cout << "============== LSM DICT ==============" << std::endl;
+
+    LsmDict dictLsm;
+    runMeasurements(dictLsm, sizes);
+
+    std::cout << "============== LSM DICT VS AVL TREE INGEST ==============" << std::endl;
+
+    runLsmMeasurements(sizes);
+
+    // A miss walks the whole list, so the list only runs with small inputs
+    const int listSizes[] = {4096, 16384, 65536};
+
+    std::cout << "============== MISS-HEAVY LOOKUPS: LIST ==============" << std::endl;
+
+    DictList missList;
+    runMissMeasurements(missList, listSizes);
+
+    std::cout << "============== MISS-HEAVY LOOKUPS: FILTERED LIST ==============" << std::endl;
+
+    DictList filteredListBase;
+    FilteredDict filteredList(filteredListBase);
+    runMissMeasurements(filteredList, listSizes);
+
+    std::cout << "============== MISS-HEAVY LOOKUPS: BINARY TREE ==============" << std::endl;
+
+    Bin missBinaryTree;
+    runMissMeasurements(missBinaryTree, sizes);
+
+    std::cout << "============== MISS-HEAVY LOOKUPS: FILTERED BINARY TREE ==============" << std::endl;
+
+    Bin filteredBinaryTreeBase;
+    FilteredDict filteredBinaryTree(filteredBinaryTreeBase);
+    runMissMeasurements(filteredBinaryTree, sizes);
+
+    std::cout << "============== MISS-HEAVY LOOKUPS: AVL TREE ==============" << std::endl;
+
+    AVLTree missAVLTree;
+    runMissMeasurements(missAVLTree, sizes);
+
+    std::cout << "============== MISS-HEAVY LOOKUPS: FILTERED AVL TREE ==============" << std::endl;
+
+    AVLTree filteredAVLTreeBase;
+    FilteredDict filteredAVLTree(filteredAVLTreeBase);
+    runMissMeasurements(filteredAVLTree, sizes);
+
+    std::cout << "============== AVL TREE STARTUP ==============" << std::endl;
+
+    runStartupMeasurements(sizes);
+
+    std::cout << "============== AVL TREE (ORDER STATISTICS) ==============" << std::endl;
+
+    // Compare insert and erase with the AVL TREE section to see the cost of
+    // keeping the subtree sizes up to date
+    AVLTree dictAVLTreeRanked(AVLTree::ORDER_STATISTICS);
+    runMeasurements(dictAVLTreeRanked, sizes);
+    std::cout << std::endl;
+    runOrderStatisticMeasurements(sizes);
+
+    std::cout << "============== AVL TREE RANGE SCANS ==============" << std::endl;
+
+    runScanMeasurements<AVLTree>(sizes);
+
+    std::cout << "============== AVL TREE PIPELINED LOOKUPS ==============" << std::endl;
+
+    runPipelinedMeasurements(sizes);
+
+    std::cout << "============== FROZEN AVL TREE ==============" << std::endl;
+
+    runFrozenMeasurements(sizes);
+
+    std::cout << "============== LEARNED INDEX: RANDOM KEYS ==============" << std::endl;
+
+    runLearnedMeasurements(sizes, createItemsRandom);
+
+    std::cout << "============== LEARNED INDEX: ASCENDING KEYS ==============" << std::endl;
+
+    runLearnedMeasurements(sizes, createItemsInOrder);
+
+    std::cout << "============== AVL TREE DUMP ==============" << std::endl;
+
+    runDumpMeasurements(sizes);
+
+    std::cout << "============== AVL TREE SET OPERATIONS ==============" << std::endl;
+
+    runSetOperationMeasurements(sizes);
+
+    std::cout << "============== AVL TREE (ARENA) ==============" << std::endl;
+
+    AVLTree dictAVLTreeArena(AVLTree::ARENA_NODES);
+    runMeasurements(dictAVLTreeArena, sizes);
+    std::cout << std::endl;
+    runClearMeasurements(dictAVLTreeArena, sizes);
+
+    std::cout << "============== COMPACT AVL TREE ==============" << std::endl;
+
+    CompactAVLTree dictCompactAVLTree;
+    runMeasurements(dictCompactAVLTree, sizes);
+
+    std::cout << "============== CONCURRENT AVL TREE ==============" << std::endl;
+
+    ConcurrentAVLTree dictConcurrentAVLTree;
+    runMeasurements(dictConcurrentAVLTree, sizes);
+
+    std::cout << "============== THROUGHPUT: AVL TREE + MUTEX ==============" << std::endl;
+
+    AVLTree lockedAVLTree;
+    LockedDict dictLockedAVLTree(lockedAVLTree);
+    runThroughputMeasurements(dictLockedAVLTree);
+
+    std::cout << "============== THROUGHPUT: CONCURRENT AVL TREE ==============" << std::endl;
+
+    ConcurrentAVLTree sharedConcurrentAVLTree;
+    runThroughputMeasurements(sharedConcurrentAVLTree);
+
+    std::cout << "============== SKIP LIST ==============" << std::endl;
+
+    SkipListDict dictSkipList;
+    runMeasurements(dictSkipList, sizes);
+
+    std::cout << "============== THROUGHPUT: SKIP LIST ==============" << std::endl;
+
+    SkipListDict sharedSkipList;
+    runThroughputMeasurements(sharedSkipList);
+
+    std::cout << "============== PERSISTENT AVL TREE ==============" << std::endl;
+
+    PersistentAVLTree dictPersistentAVLTree;
+    runMeasurements(dictPersistentAVLTree, sizes);
+
+    std::cout << "============== PERSISTENT AVL TREE SNAPSHOTS ==============" << std::endl;
+
+    runSnapshotMeasurements(sizes);
+
+    std::cout << "============== THROUGHPUT: PERSISTENT AVL TREE ==============" << std::endl;
+
+    PersistentAVLTree sharedPersistentAVLTree;
+    runThroughputMeasurements(sharedPersistentAVLTree);
+
+    std::cout << "============== GENERIC AVL TREE (DICT) ==============" << std::endl;
+
+    GenericAVLDict dictGenericAVLTree;
+    runMeasurements(dictGenericAVLTree, sizes);
+
+    std::cout << "============== GENERIC AVL TREE (DIRECT) ==============" << std::endl;
+
+    runDirectMeasurements(dictGenericAVLTree.tree(), sizes);
+
+    std::cout << "============== GENERIC AVL TREE (64-BIT KEYS) ==============" << std::endl;
+
+    GenericAVLTree<int64_t> genericAVLTree64;
+    runDirectMeasurements(genericAVLTree64, sizes);
 
     return 0;
 }
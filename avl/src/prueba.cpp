@@ -23,9 +23,25 @@
 #ifdef TEST
 // Comment and uncomment as necessary
 #include "./DictList/DictList.hpp"
+#include "./UnrolledDictList/UnrolledDictList.hpp"
 #include "./Dict/Dict.h"
 #include "./binario/Bin.hpp"
 #include "./AVLTree/AVLTree.hpp"
+#include "./BPlusTree/BPlusTree.hpp"
+#include "./CompactAVLTree/CompactAVLTree.hpp"
+#include "./GenericAVLTree/GenericAVLDict.hpp"
+#include "./ConcurrentAVLTree/ConcurrentAVLTree.hpp"
+#include "./LockedDict/LockedDict.hpp"
+#include "./PersistentAVLTree/PersistentAVLTree.hpp"
+#include "./FrozenDict/FrozenDict.hpp"
+#include "./HashDict/HashDict.hpp"
+#include "./SkipListDict/SkipListDict.hpp"
+#include "./SplayTree/SplayTree.hpp"
+#include "./AdaptiveRadixTree/AdaptiveRadixTree.hpp"
+#include "./LsmDict/LsmDict.hpp"
+#include "./FilteredDict/FilteredDict.hpp"
+#include "./PackedMemoryArray/PackedMemoryArray.hpp"
+#include "./LearnedDict/LearnedDict.hpp"
 
 void test(Dict &dict, std::string name);
 int main() {
@@ -34,13 +50,107 @@ int main() {
   DictList dictList;
   test(dictList, "List");
 
+  std::cout << "============== UNROLLED LIST ==============" << std::endl;
+  UnrolledDictList dictUnrolledList;
+  test(dictUnrolledList, "Unrolled List");
+
   std::cout << "============== BINARY TREE ==============" << std::endl;
   Bin dictBin;
   test(dictBin, "Binary Tree");
 
+  std::cout << "============== BINARY TREE (TREAP) ==============" << std::endl;
+  Bin dictTreap(Bin::TREAP);
+  test(dictTreap, "Treap");
+
   std::cout << "============== AVL TREE ==============" << std::endl;
   AVLTree dictAVL;
   test(dictAVL, "AVL Tree");
+
+  std::cout << "============== AVL TREE (ARENA) ==============" << std::endl;
+  AVLTree dictAVLArena(AVLTree::ARENA_NODES);
+  test(dictAVLArena, "AVL Tree (arena)");
+
+  std::cout << "============== AVL TREE (ORDER STATISTICS) ==============" << std::endl;
+  AVLTree dictAVLRanked(AVLTree::ORDER_STATISTICS);
+  test(dictAVLRanked, "AVL Tree (order statistics)");
+  std::cout << "rank(4) = " << dictAVLRanked.rank(4) << ", select(0) = "
+      << dictAVLRanked.select(0) << ", countRange(0, 10) = "
+      << dictAVLRanked.countRange(0, 10) << std::endl;
+
+  // Partir un árbol sin ORDER_STATISTICS hacia uno que sí lo usa debe dejar los conteos al día
+  AVLTree dictAVLPlain;
+  for (int key = 1; key < 1000; ++key) {
+    dictAVLPlain.insert(key);
+  }
+  AVLTree dictAVLUpper(AVLTree::ORDER_STATISTICS);
+  dictAVLPlain.split(500, dictAVLUpper);
+  std::cout << "split(500): rank(999) = " << dictAVLUpper.rank(999)
+      << ", countRange(501, 999) = " << dictAVLUpper.countRange(501, 999)
+      << ", select(10) = " << dictAVLUpper.select(10) << std::endl;
+
+  std::cout << "============== FROZEN AVL TREE ==============" << std::endl;
+  FrozenDict dictFrozen = dictAVLRanked.freeze();
+  std::cout << dictFrozen.toString();
+  std::cout << "contains(4) = " << dictFrozen.contains(4) << std::endl;
+
+  std::cout << "============== LEARNED INDEX ==============" << std::endl;
+  LearnedDict dictLearned(dictAVLRanked);
+  std::cout << dictLearned.toString();
+  std::cout << "contains(4) = " << dictLearned.contains(4) << std::endl;
+
+  std::cout << "============== B+ TREE ==============" << std::endl;
+  BPlusTree dictBPlus;
+  test(dictBPlus, "B+ Tree");
+
+  std::cout << "============== HASH TABLE ==============" << std::endl;
+  HashDict dictHash;
+  test(dictHash, "Hash Table");
+
+  std::cout << "============== SPLAY TREE ==============" << std::endl;
+  SplayTree dictSplay;
+  test(dictSplay, "Splay Tree");
+
+  std::cout << "============== ADAPTIVE RADIX TREE ==============" << std::endl;
+  AdaptiveRadixTree dictRadix;
+  test(dictRadix, "Adaptive Radix Tree");
+
+  std::cout << "============== LSM DICT ==============" << std::endl;
+  LsmDict dictLsm;
+  test(dictLsm, "LSM Dict");
+
+  std::cout << "============== FILTERED AVL TREE ==============" << std::endl;
+  AVLTree dictFilteredBase;
+  FilteredDict dictFiltered(dictFilteredBase);
+  test(dictFiltered, "Filtered AVL Tree");
+
+  std::cout << "============== PACKED MEMORY ARRAY ==============" << std::endl;
+  PackedMemoryArray dictPacked;
+  test(dictPacked, "Packed Memory Array");
+
+  std::cout << "============== COMPACT AVL TREE ==============" << std::endl;
+  CompactAVLTree dictCompactAVL;
+  test(dictCompactAVL, "Compact AVL Tree");
+
+  std::cout << "============== GENERIC AVL TREE ==============" << std::endl;
+  GenericAVLDict dictGenericAVL;
+  test(dictGenericAVL, "Generic AVL Tree");
+
+  std::cout << "============== CONCURRENT AVL TREE ==============" << std::endl;
+  ConcurrentAVLTree dictConcurrentAVL;
+  test(dictConcurrentAVL, "Concurrent AVL Tree");
+
+  std::cout << "============== LOCKED AVL TREE ==============" << std::endl;
+  AVLTree lockedAVL;
+  LockedDict dictLockedAVL(lockedAVL);
+  test(dictLockedAVL, "Locked AVL Tree");
+
+  std::cout << "============== SKIP LIST ==============" << std::endl;
+  SkipListDict dictSkipList;
+  test(dictSkipList, "Skip List");
+
+  std::cout << "============== PERSISTENT AVL TREE ==============" << std::endl;
+  PersistentAVLTree dictPersistentAVL;
+  test(dictPersistentAVL, "Persistent AVL Tree");
   return EXIT_SUCCESS;
 
 }